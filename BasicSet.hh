@@ -0,0 +1,460 @@
+/* tinygraph -- exploring graph conjectures on small graphs
+   Copyright (C) 2015  Falk Hüffner
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
+
+#ifndef TINYGRAPH_BASICSET_HH_INCLUDED
+#define TINYGRAPH_BASICSET_HH_INCLUDED
+
+#include <array>
+#include <cassert>
+#include <initializer_list>
+#include <iostream>
+
+#include "bits.hh"
+
+// A set of small integers in Words machine words, with the interface
+// of Set; used as Set when MAXN > WORDSIZE. The operations are plain
+// loops over the words, which the compiler turns into vector
+// instructions for -march=native.
+template<int Words>
+class BasicSet {
+public:
+    BasicSet(std::initializer_list<int> xs) : words_() {
+	for (int x : xs)
+	    add(x);
+    }
+    BasicSet() : words_() { }
+    // the elements < x
+    static BasicSet ofRange(int x) {
+	assert(x >= 0 && x <= MAX_ELEMENT + 1);
+	BasicSet s;
+	for (int i = 0; i < Words && x > i * WORDSIZE; ++i) {
+	    int k = x - i * WORDSIZE;
+	    s.words_[i] = k >= WORDSIZE ? word(-1) : word(-1) >> (WORDSIZE - k);
+	}
+	return s;
+    }
+
+    static constexpr int WORDS = Words;
+    static constexpr int MAX_ELEMENT = Words * WORDSIZE - 1;
+
+    bool isEmpty() const {
+	word any = 0;
+	for (int i = 0; i < Words; ++i)
+	    any |= words_[i];
+	return any == 0;
+    }
+    bool nonempty() const { return !isEmpty(); }
+    int size() const {
+	int size = 0;
+	for (int i = 0; i < Words; ++i)
+	    size += popcount(words_[i]);
+	return size;
+    }
+    bool contains(int x) const {
+	assert(x >= 0 && x <= MAX_ELEMENT);
+	return words_[x / WORDSIZE] & bit(x);
+    }
+    int min() const {
+	assert(!isEmpty());
+	int i = 0;
+	while (words_[i] == 0)
+	    ++i;
+	return i * WORDSIZE + ctz(words_[i]);
+    }
+    int max() const {
+	assert(!isEmpty());
+	int i = Words - 1;
+	while (words_[i] == 0)
+	    --i;
+	return i * WORDSIZE + WORDSIZE - 1 - clz(words_[i]);
+    }
+
+    void add(int x)     { assert(x >= 0 && x <= MAX_ELEMENT); words_[x / WORDSIZE] |=  bit(x); }
+    void discard(int x) { assert(x >= 0 && x <= MAX_ELEMENT); words_[x / WORDSIZE] &= ~bit(x); }
+    void toggle(int x)  { assert(x >= 0 && x <= MAX_ELEMENT); words_[x / WORDSIZE] ^=  bit(x); }
+    void remove(int x)  { assert(contains(x)); discard(x); }
+    int pop() { int x = min(); discard(x); return x; }
+
+    bool operator==(const BasicSet& other) const { return words_ == other.words_; }
+    bool operator!=(const BasicSet& other) const { return words_ != other.words_; }
+
+    BasicSet operator~() const {
+	BasicSet s;
+	for (int i = 0; i < Words; ++i)
+	    s.words_[i] = ~words_[i];
+	return s;
+    }
+
+    BasicSet& operator&=(const BasicSet& other) {
+	for (int i = 0; i < Words; ++i)
+	    words_[i] &= other.words_[i];
+	return *this;
+    }
+    BasicSet& operator|=(const BasicSet& other) {
+	for (int i = 0; i < Words; ++i)
+	    words_[i] |= other.words_[i];
+	return *this;
+    }
+    BasicSet& operator^=(const BasicSet& other) {
+	for (int i = 0; i < Words; ++i)
+	    words_[i] ^= other.words_[i];
+	return *this;
+    }
+    BasicSet& operator-=(const BasicSet& other) {
+	for (int i = 0; i < Words; ++i)
+	    words_[i] &= ~other.words_[i];
+	return *this;
+    }
+
+    BasicSet operator&(const BasicSet& other) const { BasicSet s = *this; return s &= other; }
+    BasicSet operator|(const BasicSet& other) const { BasicSet s = *this; return s |= other; }
+    BasicSet operator^(const BasicSet& other) const { BasicSet s = *this; return s ^= other; }
+    BasicSet operator-(const BasicSet& other) const { BasicSet s = *this; return s -= other; }
+
+    BasicSet& operator+=(int x) { add(x);     return *this; }
+    BasicSet& operator-=(int x) { discard(x); return *this; }
+
+    BasicSet operator+(int x) const { BasicSet s = *this; return s += x; }
+    BasicSet operator-(int x) const { BasicSet s = *this; return s -= x; }
+
+    // return only elements > x
+    BasicSet above(int x) const { return *this - ofRange(x + 1); }
+    // return only elements <= x
+    BasicSet belowEq(int x) const { return *this & ofRange(x + 1); }
+    // return only elements < x
+    BasicSet below(int x) const { return *this & ofRange(x); }
+
+    bool isSubset(const BasicSet& other) const { return (*this - other).isEmpty(); }
+    bool isSuperset(const BasicSet& other) const { return other.isSubset(*this); }
+
+    // the elements of this at the positions of mask, renumbered to
+    // 0, ..., |mask| - 1
+    BasicSet extract(const BasicSet& mask) const {
+	BasicSet s;
+	int pos = 0;
+	for (int i = 0; i < Words; ++i) {
+	    word x = extractBits(words_[i], mask.words_[i]);
+	    s.orAt(x, pos);
+	    pos += popcount(mask.words_[i]);
+	}
+	return s;
+    }
+    // without x, with the elements above x moved down by one
+    BasicSet deleted(int x) const {
+	assert(x >= 0 && x <= MAX_ELEMENT);
+	BasicSet s = *this;
+	int i = x / WORDSIZE;
+	s.words_[i] = delbit(words_[i], x % WORDSIZE);
+	for (; i < Words - 1; ++i) {
+	    s.words_[i] |= words_[i + 1] << (WORDSIZE - 1);
+	    s.words_[i + 1] = words_[i + 1] >> 1;
+	}
+	return s;
+    }
+    // with all elements increased by k; those beyond MAX_ELEMENT are lost
+    BasicSet shifted(int k) const {
+	assert(k >= 0);
+	BasicSet s;
+	for (int i = 0; i < Words; ++i)
+	    s.orAt(words_[i], i * WORDSIZE + k);
+	return s;
+    }
+
+    // as row of m nauty setwords, which have their bits in reverse order
+    void toNauty(word* row, int m) const {
+	for (int i = 0; i < m; ++i)
+	    row[i] = i < Words ? reverseBits(words_[i]) : 0;
+    }
+    static BasicSet ofNauty(const word* row, int m) {
+	assert(m <= Words);
+	BasicSet s;
+	for (int i = 0; i < m; ++i)
+	    s.words_[i] = reverseBits(row[i]);
+	return s;
+    }
+
+    class Iterator {
+	friend BasicSet;
+    public:
+	bool operator!=(const Iterator& it) const { return i_ != it.i_ || w_ != it.w_; }
+	int operator*() const { return i_ * WORDSIZE + ctz(w_); }
+	Iterator& operator++() { w_ &= w_ - 1; skip(); return *this; }
+    private:
+	Iterator(const std::array<word, Words>& words, int i)
+	    : words_(words), i_(i), w_(i < Words ? words[i] : 0) {
+	    skip();
+	}
+	void skip() {
+	    while (w_ == 0) {
+		if (++i_ >= Words) {
+		    i_ = Words;
+		    return;
+		}
+		w_ = words_[i_];
+	    }
+	}
+	std::array<word, Words> words_;
+	int i_;
+	word w_;
+    };
+    Iterator begin() const { return Iterator(words_, 0); }
+    Iterator end() const { return Iterator(words_, Words); }
+
+    // as for Set
+    template<typename It>
+    class Range {
+    public:
+	Range(It first, uint64_t size) : first_(first), size_(size) { }
+	class Iterator {
+	    friend Range;
+	public:
+	    bool operator!=(const Iterator&) const { return left_ != 0; }
+	    BasicSet operator*() const { return *it_; }
+	    Iterator& operator++() { if (--left_) ++it_; return *this; }
+	private:
+	    Iterator(It it, uint64_t left) : it_(it), left_(left) { }
+	    It it_;
+	    uint64_t left_;
+	};
+	Iterator begin() const { return Iterator(first_, size_); }
+	Iterator end() const { return Iterator(first_, 0); }
+    private:
+	It first_;
+	uint64_t size_;
+    };
+
+    class Subsets {
+    public:
+	Subsets(const BasicSet& set) : set_(set) { }
+	class Iterator {
+	    friend Subsets;
+	public:
+	    bool operator!=(const Iterator&) const { return !done_; }
+	    BasicSet operator*() const { return subset_; }
+	    // subset = (subset - set) & set, with multi-word subtraction
+	    Iterator& operator++() {
+		word borrow = 0;
+		for (int i = 0; i < Words; ++i) {
+		    word x = subset_.words_[i], y = set_.words_[i];
+		    word d = x - y;
+		    word nextBorrow = (x < y) | (d < borrow);
+		    subset_.words_[i] = (d - borrow) & y;
+		    borrow = nextBorrow;
+		}
+		done_ = subset_.isEmpty();
+		return *this;
+	    }
+	private:
+	    Iterator(const BasicSet& set, bool done, const BasicSet& subset = BasicSet())
+		: set_(set), subset_(subset), done_(done) { }
+	    BasicSet set_;
+	    BasicSet subset_;
+	    bool done_;
+	};
+	Iterator begin() const { return Iterator(set_, false); }
+	Iterator end() const { return Iterator(set_, true); }
+
+	uint64_t size() const { assert(set_.size() < 64); return uint64_t(1) << set_.size(); }
+	uint64_t rank(const BasicSet& subset) const {
+	    assert(subset.isSubset(set_));
+	    return subset.extract(set_).low64();
+	}
+	BasicSet unrank(uint64_t r) const { assert(r < size()); return deposit(r, set_); }
+	Range<Iterator> range(uint64_t first, uint64_t last) const {
+	    assert(first <= last && last <= size());
+	    return Range<Iterator>(Iterator(set_, false, first < last ? unrank(first) : BasicSet()),
+				   last - first);
+	}
+    private:
+	BasicSet set_;
+    };
+    Subsets subsets() const { return Subsets(*this); }
+
+    class GrayCodeStep {
+	friend BasicSet;
+    public:
+	BasicSet subset() const { BasicSet s; s.words_ = subset_; return s; }
+	int changed() const { return changed_; }
+	bool added() const { return changed_ >= 0 && subset().contains(changed_); }
+    private:
+	GrayCodeStep(const BasicSet& subset, int changed) : subset_(subset.words_), changed_(changed) { }
+	std::array<word, Words> subset_;
+	int changed_;
+    };
+
+    // as for Set
+    class GrayCodeSubsets {
+    public:
+	GrayCodeSubsets(const BasicSet& set) : set_(set) { }
+	class Iterator {
+	    friend GrayCodeSubsets;
+	public:
+	    bool operator!=(const Iterator&) const { return !done_; }
+	    GrayCodeStep operator*() const { return GrayCodeStep(subset_, changed_); }
+	    Iterator& operator++() {
+		++i_;
+		BasicSet bit = deposit(i_ & -i_, set_);
+		subset_ ^= bit;
+		changed_ = bit.nonempty() ? bit.min() : -1;
+		done_ = bit.isEmpty();
+		return *this;
+	    }
+	private:
+	    Iterator(const BasicSet& set, bool done) : set_(set), i_(0), changed_(-1), done_(done) {
+		assert(set.size() < 64);
+	    }
+	    BasicSet set_;
+	    uint64_t i_;
+	    BasicSet subset_;
+	    int changed_;
+	    bool done_;
+	};
+	Iterator begin() const { return Iterator(set_, false); }
+	Iterator end() const { return Iterator(set_, true); }
+    private:
+	BasicSet set_;
+    };
+    GrayCodeSubsets grayCodeSubsets() const { return GrayCodeSubsets(*this); }
+
+    // in the same order as for Set, colexicographic
+    class Combinations {
+    public:
+	Combinations(const BasicSet& set, int k) : set_(set), k_(k) { }
+	class Iterator {
+	    friend Combinations;
+	public:
+	    bool operator!=(const Iterator& it) const {
+		return done_ != it.done_ || (!done_ && comb_ != it.comb_);
+	    }
+	    BasicSet operator*() const { return comb_; }
+	    Iterator& operator++() {
+		// move up the lowest element that can move, and the
+		// ones below it back to the start
+		int below = 0;
+		for (int x : comb_) {
+		    BasicSet up = set_.above(x);
+		    if (up.isEmpty())
+			break;
+		    int y = up.min();
+		    if (!comb_.contains(y)) {
+			comb_ = (comb_.above(x) + y) | lowest(set_, below);
+			return *this;
+		    }
+		    ++below;
+		}
+		done_ = true;
+		return *this;
+	    }
+	private:
+	    Iterator(const BasicSet& set, const BasicSet& comb, bool done)
+		: set_(set), comb_(comb), done_(done) { }
+	    BasicSet set_;
+	    BasicSet comb_;
+	    bool done_;
+	};
+	Iterator begin() const {
+	    return Iterator(set_, lowest(set_, k_), k_ > set_.size());
+	}
+	Iterator end() const { return Iterator(set_, BasicSet(), true); }
+
+	uint64_t size() const { return binomial(set_.size(), k_); }
+	uint64_t rank(const BasicSet& comb) const {
+	    assert(comb.isSubset(set_) && comb.size() == k_);
+	    uint64_t r = 0;
+	    int i = 0;
+	    for (int p : comb.extract(set_))
+		r += binomial(p, ++i);
+	    return r;
+	}
+	BasicSet unrank(uint64_t r) const {
+	    assert(r < size());
+	    uint64_t positions = 0;
+	    int p = set_.size();
+	    for (int i = k_; i >= 1; --i) {
+		do
+		    --p;
+		while (binomial(p, i) > r);
+		r -= binomial(p, i);
+		positions |= uint64_t(1) << p;
+	    }
+	    return deposit(positions, set_);
+	}
+	Range<Iterator> range(uint64_t first, uint64_t last) const {
+	    assert(first <= last && last <= size());
+	    return Range<Iterator>(Iterator(set_, first < last ? unrank(first) : BasicSet(), false),
+				   last - first);
+	}
+    private:
+	BasicSet set_;
+	int k_;
+    };
+    Combinations combinations(int k) const { return Combinations(*this, k); }
+
+private:
+    static word bit(int x) { return word(1) << (x % WORDSIZE); }
+    // or x shifted up by pos bits into this
+    void orAt(word x, int pos) {
+	int i = pos / WORDSIZE, shift = pos % WORDSIZE;
+	if (i < Words)
+	    words_[i] |= x << shift;
+	if (shift && i + 1 < Words)
+	    words_[i + 1] |= x >> (WORDSIZE - shift);
+    }
+    // the elements of this below 64 as bits
+    uint64_t low64() const {
+	uint64_t x = 0;
+	for (int i = 0; i < Words && i * WORDSIZE < 64; ++i)
+	    x |= uint64_t(words_[i]) << (i * WORDSIZE);
+	return x;
+    }
+    // the elements of mask at the positions of the bits of x
+    static BasicSet deposit(uint64_t x, BasicSet mask) {
+	BasicSet s;
+	for (; x && mask.nonempty(); x >>= 1) {
+	    int y = mask.pop();
+	    if (x & 1)
+		s.add(y);
+	}
+	return s;
+    }
+    // the k smallest elements of s
+    static BasicSet lowest(BasicSet s, int k) {
+	BasicSet r;
+	for (int i = 0; i < k && s.nonempty(); ++i)
+	    r.add(s.pop());
+	return r;
+    }
+    std::array<word, Words> words_;
+};
+
+template<int Words>
+constexpr int BasicSet<Words>::MAX_ELEMENT;
+
+template<int Words>
+std::ostream& operator<<(std::ostream& out, const BasicSet<Words>& s) {
+    out << '{';
+    bool first = true;
+    for (int x : s) {
+	if (!first)
+	    out << ", ";
+	out << x;
+	first = false;
+    }
+    return out << '}';
+}
+
+#endif  // TINYGRAPH_BASICSET_HH_INCLUDED
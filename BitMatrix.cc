@@ -0,0 +1,119 @@
+/* tinygraph -- exploring graph conjectures on small graphs
+   Copyright (C) 2015  Falk Hüffner
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
+
+#include "BitMatrix.hh"
+
+#include <algorithm>
+#include <ostream>
+
+BitMatrix BitMatrix::identity(int n) {
+    BitMatrix a(n);
+    for (int i = 0; i < n; ++i)
+	a.rows_[i] = {i};
+    return a;
+}
+
+BitMatrix BitMatrix::ofGraph(const Graph& g) {
+    BitMatrix a(g.n());
+    std::copy(g.neighbors(), g.neighbors() + g.n(), a.rows_.begin());
+    return a;
+}
+
+BitMatrix BitMatrix::transpose() const {
+    BitMatrix t(n_);
+    for (int i = 0; i < n_; ++i)
+	for (int j : rows_[i])
+	    t.rows_[j].add(i);
+    return t;
+}
+
+// "Four Russians": split the rows of b into groups of k, tabulate the
+// unions of all 2^k subsets of each group, and then build each row of
+// the product from one table lookup per group, for O(n^2 / log n)
+// set operations instead of O(n^2)
+BitMatrix BitMatrix::operator*(const BitMatrix& b) const {
+    assert(n_ == b.n_);
+    int k = 1;
+    while (k < 8 && (2 << k) <= n_)
+	++k;
+    std::array<Set, 1 << 8> unions;
+    BitMatrix c(n_);
+    for (int first = 0; first < n_; first += k) {
+	Set group = Set::ofRange(std::min(first + k, n_)) - Set::ofRange(first);
+	auto subsets = group.subsets();
+	int i = 0;
+	for (Set s : subsets) {
+	    if (i > 0) {
+		int low = s.min();
+		unions[i] = unions[subsets.rank(s - low)] | b.rows_[low];
+	    }
+	    ++i;
+	}
+	for (int u = 0; u < n_; ++u)
+	    c.rows_[u] |= unions[subsets.rank(rows_[u] & group)];
+    }
+    return c;
+}
+
+// Warshall's algorithm, one row union per pair
+BitMatrix BitMatrix::transitiveClosure() const {
+    BitMatrix c = *this;
+    for (int k = 0; k < n_; ++k)
+	for (int i = 0; i < n_; ++i)
+	    if (c.rows_[i].contains(k))
+		c.rows_[i] |= c.rows_[k];
+    return c;
+}
+
+std::vector<int> BitMatrix::andCounts(const BitMatrix& b) const {
+    assert(n_ == b.n_);
+    std::vector<int> counts(n_ * n_);
+    for (int i = 0; i < n_; ++i)
+	for (int j = 0; j < n_; ++j)
+	    counts[i * n_ + j] = (rows_[i] & b.rows_[j]).size();
+    return counts;
+}
+
+std::vector<BitMatrix> BitMatrix::distanceLayers() const {
+    std::vector<BitMatrix> layers = {identity(n_)};
+    BitMatrix reached = layers[0];
+    while (true) {
+	// The layers partition each row, so over all of them this product
+	// takes n^2 row unions, fewer than the tables of operator*.
+	BitMatrix next(n_);
+	bool empty = true;
+	for (int u = 0; u < n_; ++u) {
+	    for (int v : layers.back().rows_[u])
+		next.rows_[u] |= rows_[v];
+	    next.rows_[u] -= reached.rows_[u];
+	    reached.rows_[u] |= next.rows_[u];
+	    empty &= next.rows_[u].isEmpty();
+	}
+	if (empty)
+	    return layers;
+	layers.push_back(next);
+    }
+}
+
+std::ostream& operator<<(std::ostream& out, const BitMatrix& a) {
+    for (int i = 0; i < a.n(); ++i) {
+	for (int j = 0; j < a.n(); ++j)
+	    out << (a.get(i, j) ? '1' : '0');
+	out << '\n';
+    }
+    return out;
+}
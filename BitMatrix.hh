@@ -0,0 +1,84 @@
+/* tinygraph -- exploring graph conjectures on small graphs
+   Copyright (C) 2015  Falk Hüffner
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
+
+#ifndef TINYGRAPH_BITMATRIX_HH_INCLUDED
+#define TINYGRAPH_BITMATRIX_HH_INCLUDED
+
+#include <array>
+#include <vector>
+
+#include "Graph.hh"
+#include "Set.hh"
+
+// n x n Boolean matrix with one Set per row, n <= MAXN; row i
+// contains j iff entry (i, j) is 1. Rows and columns at n and above
+// are kept empty.
+class BitMatrix {
+public:
+    explicit BitMatrix(int n) : n_(n), rows_() { assert(n >= 0 && n <= MAXN); }
+    static BitMatrix identity(int n);
+    // the adjacency matrix
+    static BitMatrix ofGraph(const Graph& g);
+
+    int n() const { return n_; }
+    Set row(int i) const { return rows_[i]; }
+    bool get(int i, int j) const { return rows_[i].contains(j); }
+    void set(int i, int j) { rows_[i].add(j); }
+
+    bool operator==(const BitMatrix& b) const {
+	return n_ == b.n_ && std::equal(rows_.begin(), rows_.begin() + n_, b.rows_.begin());
+    }
+    bool operator!=(const BitMatrix& b) const { return !(*this == b); }
+    BitMatrix& operator|=(const BitMatrix& b) {
+	assert(n_ == b.n_);
+	for (int i = 0; i < n_; ++i)
+	    rows_[i] |= b.rows_[i];
+	return *this;
+    }
+    BitMatrix& operator&=(const BitMatrix& b) {
+	assert(n_ == b.n_);
+	for (int i = 0; i < n_; ++i)
+	    rows_[i] &= b.rows_[i];
+	return *this;
+    }
+    BitMatrix operator|(const BitMatrix& b) const { BitMatrix c = *this; return c |= b; }
+    BitMatrix operator&(const BitMatrix& b) const { BitMatrix c = *this; return c &= b; }
+
+    BitMatrix transpose() const;
+    // Boolean product: row i of the result is the union of the rows j
+    // of b for j in row i
+    BitMatrix operator*(const BitMatrix& b) const;
+    // entry (i, j) is 1 iff there is a path of length >= 1 from i to j
+    BitMatrix transitiveClosure() const;
+    // the integer product with b transposed: entry i * n() + j is
+    // |row(i) & b.row(j)|, so for an adjacency matrix a, a.andCounts(a)
+    // gives the numbers of common neighbors, or of walks of length 2
+    std::vector<int> andCounts(const BitMatrix& b) const;
+
+    // layers[d].row(u) is the set of vertices at distance d from u in
+    // the graph with this adjacency matrix, up to the largest distance
+    // that occurs; vertices in other components are in no layer
+    std::vector<BitMatrix> distanceLayers() const;
+
+private:
+    int n_;
+    std::array<Set, MAXN> rows_;
+};
+
+std::ostream& operator<<(std::ostream& out, const BitMatrix& a);
+
+#endif  // TINYGRAPH_BITMATRIX_HH_INCLUDED
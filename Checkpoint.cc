@@ -0,0 +1,74 @@
+/* tinygraph -- exploring graph conjectures on small graphs
+   Copyright (C) 2015  Falk Hüffner
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
+
+#include "Checkpoint.hh"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <sys/stat.h>
+
+Checkpoint::Checkpoint(const std::string& dir, const std::string& run) : dir_(dir), run_(run) {
+    if (mkdir(dir_.c_str(), 0777) != 0 && errno != EEXIST)
+	throw std::runtime_error("cannot create " + dir_ + ": " + strerror(errno));
+    std::string runFile = dir_ + "/run";
+    std::ifstream in(runFile);
+    if (in) {
+	std::string existing;
+	std::getline(in, existing);
+	if (existing != run_)
+	    throw std::runtime_error(dir_ + " holds parts of a different run: " + existing);
+    } else {
+	std::ofstream out(runFile);
+	out << run_ << '\n';
+	if (!out)
+	    throw std::runtime_error("cannot write " + runFile);
+    }
+}
+
+std::string Checkpoint::fileName(int n, int res, int mod) const {
+    return dir_ + "/n" + std::to_string(n) + '-' + std::to_string(res) + "of" + std::to_string(mod);
+}
+
+// part files repeat the run, so a stray file from another run is never
+// taken for a result
+bool Checkpoint::load(int n, int res, int mod, std::string& result) const {
+    std::ifstream in(fileName(n, res, mod));
+    std::string run;
+    if (!std::getline(in, run) || run != run_)
+	return false;
+    return bool(std::getline(in, result));
+}
+
+// written to a temporary file first, so a killed process never leaves
+// a partial result behind
+void Checkpoint::store(int n, int res, int mod, const std::string& result) const {
+    std::string name = fileName(n, res, mod);
+    std::string tmpName = name + ".tmp";
+    {
+	std::ofstream out(tmpName);
+	out << run_ << '\n' << result << '\n';
+	out.flush();
+	if (!out)
+	    throw std::runtime_error("cannot write " + tmpName);
+    }
+    if (rename(tmpName.c_str(), name.c_str()) != 0)
+	throw std::runtime_error("cannot rename " + tmpName + ": " + strerror(errno));
+}
@@ -0,0 +1,42 @@
+/* tinygraph -- exploring graph conjectures on small graphs
+   Copyright (C) 2015  Falk Hüffner
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
+
+#ifndef TINYGRAPH_CHECKPOINT_HH_INCLUDED
+#define TINYGRAPH_CHECKPOINT_HH_INCLUDED
+
+#include <string>
+
+// Results of finished parts (res of mod, see Parallel) kept as one
+// file per part in a directory, so that an interrupted run can be
+// resumed and several machines sharing the directory can split the
+// parts of a run among themselves.
+class Checkpoint {
+public:
+    // run describes the computation (program and arguments); a
+    // directory can only hold parts of a single run
+    Checkpoint(const std::string& dir, const std::string& run);
+
+    bool load(int n, int res, int mod, std::string& result) const;
+    void store(int n, int res, int mod, const std::string& result) const;
+
+private:
+    std::string fileName(int n, int res, int mod) const;
+    std::string dir_;
+    std::string run_;
+};
+
+#endif  // TINYGRAPH_CHECKPOINT_HH_INCLUDED
@@ -16,6 +16,7 @@
    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
 
 #include "Classes.hh"
+#include "BitMatrix.hh"
 #include "Invariants.hh"
 
 #include <cstring>
@@ -96,15 +97,19 @@ bool isPerfect(const Graph& g) {
     return !Subgraph::hasOddHole(g) && !Subgraph::hasOddHole(g.complement());
 }
 
-bool isSplit(const Graph& g) {
-    int n = g.n();
+// whether the subgraph induced by vs is split, from its degrees
+static bool isSplit(const Graph& g, Set vs) {
+    int n = vs.size();
     if (n == 0)
 	return true;
+    int inducedDegs[MAXN];
+    Rows::popcounts(g.neighbors(), g.n(), vs, inducedDegs);
     int degs[n];
-    for (int u = 0; u < n; ++u)
-	degs[u] = g.deg(u);
+    int i = 0;
+    for (int u : vs)
+	degs[i++] = inducedDegs[u];
     std::sort(degs, degs + n, std::greater<std::size_t>());
-    int sum1 = 0, i;
+    int sum1 = 0;
     for (i = 0; i < n && degs[i] >= i; ++i)
         sum1 += degs[i];
     int m = i;
@@ -115,6 +120,10 @@ bool isSplit(const Graph& g) {
     return splittance2 == 0;
 }
 
+bool isSplit(const Graph& g) {
+    return isSplit(g, g.vertices());
+}
+
 static bool isCograph(const Graph& g, const bool mustBeDisconnected) {
     if (g.n() < 4)
 	return true;
@@ -175,9 +184,14 @@ bool isSplitClusterGraph(const Graph& g) {
 }
 
 bool isMonopolar(const Graph& g) {
-    for (Set is : g.vertices().subsets())
-        if (isIndependentSet(g, is) && !Subgraph::hasInducedP3(g.subgraph(g.vertices() - is)))
+    // the candidate independent set changes by one vertex per step
+    Graph::InducedEdges is(g);
+    for (auto step : g.vertices().grayCodeSubsets()) {
+	if (step.changed() >= 0)
+	    is.toggle(step.changed());
+	if (is.m() == 0 && !Subgraph::hasInducedP3(g.subgraph(g.vertices() - is.vertices())))
 	    return true;
+    }
     return false;
 }
 
@@ -263,7 +277,6 @@ bool isTwoEdgeConnected(const Graph& g) {
     Set backEdges[n];
     int dfsOrder[n];
     std::memset(dfsNumber, 0, sizeof dfsNumber);
-    std::memset(backEdges, 0, sizeof backEdges);
     int d = 0;
     // dfs numbering starts at 1
     dfs(g, dfsNumber, dfsParent, dfsOrder, backEdges, 0, 0, d);
@@ -309,7 +322,6 @@ bool isTwoVertexConnected(const Graph& g) {
     Set backEdges[n];
     int dfsOrder[n];
     std::memset(dfsNumber, 0, sizeof dfsNumber);
-    std::memset(backEdges, 0, sizeof backEdges);
     int d = 0;
     dfs(g, dfsNumber, dfsParent, dfsOrder, backEdges, 0, 0, d);
     if (d != g.n())
@@ -433,8 +445,13 @@ int dist(const Graph& g, int u, int v) {
 bool isDistanceHereditary(const Graph& g) {
     int d[g.n()][g.n()];
     for (int u : g.vertices())
-	for (int v : g.vertices().above(u))
-	    d[u][v] = d[v][u] =  dist(g, u, v);
+	for (int v : g.vertices())
+	    d[u][v] = 1000000;
+    std::vector<BitMatrix> layers = BitMatrix::ofGraph(g).distanceLayers();
+    for (size_t k = 0; k < layers.size(); ++k)
+	for (int u : g.vertices())
+	    for (int v : layers[k].row(u))
+		d[u][v] = k;
     // for every four vertices u, v, w, and x, at least two of the
     // three sums of distances d(u,v)+d(w,x), d(u,w)+d(v,x), and
     // d(u,x)+d(v,w) are equal to each other
@@ -596,7 +613,7 @@ bool isHoang(const Graph& g) {
 
 bool isTwoSplit(const Graph& g) {
     for (auto vs : g.vertices().subsets())
-	if (isSplit(g.subgraph(vs)) && isSplit(g.subgraph(g.vertices() - vs)))
+	if (isSplit(g, vs) && isSplit(g, g.vertices() - vs))
 	    return true;
     return false;
 }
@@ -0,0 +1,60 @@
+/* tinygraph -- exploring graph conjectures on small graphs
+   Copyright (C) 2015  Falk Hüffner
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
+
+#ifndef TINYGRAPH_COUNTER_HH_INCLUDED
+#define TINYGRAPH_COUNTER_HH_INCLUDED
+
+#include "Graph.hh"
+
+inline bignum toBignum(uint128 x) {
+    bignum r = uint64_t(x >> 64);
+    r <<= 64;
+    r += uint64_t(x);
+    return r;
+}
+
+// A bignum sum for hot loops: additions go to a machine word, which is
+// only carried over into the bignum when it would overflow.
+class Counter {
+public:
+    Counter() : word_(0), big_(0) { }
+
+    Counter& operator+=(uint128 x) {
+	if (word_ + x < word_) {
+	    big_ += toBignum(word_);
+	    word_ = 0;
+	}
+	word_ += x;
+	return *this;
+    }
+    Counter& operator+=(const bignum& x) {
+	big_ += x;
+	return *this;
+    }
+
+    bignum get() const { return big_ + toBignum(word_); }
+    void clear() {
+	word_ = 0;
+	big_ = 0;
+    }
+
+private:
+    uint128 word_;
+    bignum big_;
+};
+
+#endif  // TINYGRAPH_COUNTER_HH_INCLUDED
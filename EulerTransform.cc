@@ -17,81 +17,137 @@
 
 #include "EulerTransform.hh"
 
+#include <algorithm>
+
 namespace EulerTransform {
 
-mpz_class combinations(const mpz_class& n, const mpz_class& k) {
-    if (k > n)
-	throw std::domain_error("combinations");
-    if (k > n / 2)
-	return combinations(n, n - k);
-    if (!k.fits_ulong_p())
-	throw std::domain_error("combinations");
-    mpz_class r;
-    mpz_bin_ui(r.get_mpz_t(), n.get_mpz_t(), k.get_ui());
-    return r;
+// c_n = sum over divisors d of n of d * a_d
+static bignum divisorSum(const std::vector<bignum>& a, int n) {
+    bignum c = 0;
+    for (int d = 1; d * d <= n; ++d) {
+	if (n % d)
+	    continue;
+	c += d * a[d];
+	if (d * d != n)
+	    c += (n / d) * a[n / d];
+    }
+    return c;
+}
+
+// b_n = (1/n) sum_{k=1}^n c_k b_{n-k}
+const bignum& Transform::push(const bignum& a) {
+    int n = a_.size();
+    a_.push_back(a);
+    if (n == 0) {
+	c_.push_back(0);
+	b_.push_back(1);
+	return b_.back();
+    }
+    c_.push_back(divisorSum(a_, n));
+    bignum sum = 0;
+    for (int k = 1; k <= n; ++k)
+	sum += c_[k] * b_[n - k];
+    assert(sum % n == 0);
+    b_.push_back(sum / n);
+    return b_.back();
 }
 
-bignum n_multicombinations(bignum n, bignum k) {
-    if (k == 0)
-	return 0;
-    return combinations(k + n - 1, n);
+static int moebius(int n) {
+    int mu = 1;
+    for (int p = 2; p * p <= n; ++p) {
+	if (n % p)
+	    continue;
+	n /= p;
+	if (n % p == 0)
+	    return 0;
+	mu = -mu;
+    }
+    return n > 1 ? -mu : mu;
 }
 
-// based on http://code.activestate.com/recipes/218332-generator-for-integer-partitions/#c5
-// by Tim Peters
-void integerPartitions(int n, std::function<void(Set, const std::vector<int>&)> f) {
+// c_n = n b_n - sum_{k=1}^{n-1} c_k b_{n-k}, a_n = (1/n) sum_{d|n} mu(n/d) c_d
+const bignum& InverseTransform::push(const bignum& b) {
+    int n = b_.size();
+    b_.push_back(b);
     if (n == 0) {
-        f({}, {});
-	return;
+	c_.push_back(0);
+	a_.push_back(b);
+	return a_.back();
     }
+    bignum c = n * b;
+    for (int k = 1; k < n; ++k)
+	c -= c_[k] * b_[n - k];
+    c_.push_back(c);
+    bignum sum = 0;
+    for (int d = 1; d <= n; ++d)
+	if (n % d == 0)
+	    sum += moebius(n / d) * c_[d];
+    assert(sum % n == 0);
+    a_.push_back(sum / n);
+    return a_.back();
+}
 
-    std::vector<int> ms(n + 1);
-    ms[n] = 1;
-    Set keys = {n};
-    f(keys, ms);
-
-    while(keys != Set({1})) {
-	int reuse;
-        if (keys.min() == 1) {
-            keys.discard(1);
-	    reuse = ms[1];
-	    ms[1] = 0;
-	} else {
-            reuse = 0;
-	}
-        int i = keys.min();
-        int newcount = --ms[i];
-        reuse += i;
-        if (newcount == 0) {
-	    keys.discard(keys.min());
-	    ms[i] = 0;
+// b_n = sum_{k=1}^n binom(n-1, k-1) a_k b_{n-k}, choosing the a_k
+// object that holds label n
+const bignum& ExponentialTransform::push(const bignum& a) {
+    int n = a_.size();
+    a_.push_back(a);
+    if (n == 0) {
+	b_.push_back(1);
+	return b_.back();
+    }
+    bignum sum = 0;
+    bignum binom = 1;
+    for (int k = 1; k <= n; ++k) {
+	sum += binom * a_[k] * b_[n - k];
+	binom = binom * (n - k) / k;
+    }
+    b_.push_back(sum);
+    return b_.back();
+}
+
+// b_n = n! [x^{n-1}] exp(f), which needs f up to x^{n-1}, and thereby
+// r and the a_k only up to index n - 1 and n, respectively
+const bignum& BlockTransform::push(const bignum& a) {
+    int n = a_.size();
+    a_.push_back(a);
+    if (n == 0) {
+	r_.push_back(0);
+	b_.push_back(1);
+	return b_.back();
+    }
+    int j = n - 1;
+    // column j of the powers, p_k = p_{k-1} r / k
+    if (int(p_.size()) <= j)
+	p_.resize(j + 1);
+    for (int k = 1; k <= j; ++k) {
+	p_[k].resize(j + 1);
+	if (k == 1) {
+	    p_[k][j] = r_[j];
+	    continue;
 	}
-        keys.add(--i);
-	div_t qr = div(reuse, i);
-        ms[i] = qr.quot;
-	int r = qr.rem;
-        if (r) {
-            ms[r] = 1;
-            keys.add(r);
+	bignum sum = 0;
+	bignum binom = 1;
+	for (int i = 0; i < j; ++i) {
+	    sum += binom * p_[k - 1][i] * r_[j - i];
+	    binom = binom * (j - i) / (i + 1);
 	}
-	f(keys, ms);
+	assert(sum % k == 0);
+	p_[k][j] = sum / k;
     }
+    bignum f = 0;
+    for (int k = 1; k <= j; ++k)
+	f += a_[k + 1] * p_[k][j];
+    b_.push_back(exp_.push(f));
+    r_.push_back(n * b_.back());
+    return b_.back();
 }
 
 std::vector<bignum> transform(const std::vector<bignum>& seq) {
-    std::vector<bignum> transformed;
-    for (int n = 0; n < int(seq.size()); ++n) {
-        bignum count = 0;
-	integerPartitions(n,
-			  [&count,&seq](Set keys, const std::vector<int>& mult) {
-			      bignum c = 1;
-			      for (auto size : keys)
-				  c *= n_multicombinations(mult[size], seq[size]);
-			      count += c;
-			  });
-        transformed.push_back(count);
-    }
-    return transformed;
+    Transform t;
+    for (const auto& a : seq)
+	t.push(a);
+    return t.result();
 }
 
 std::vector<bignum> transform(const std::vector<uint64_t>& s) {
@@ -99,49 +155,94 @@ std::vector<bignum> transform(const std::vector<uint64_t>& s) {
     return transform(sBig);
 }
 
+std::vector<bignum> inverseTransform(const std::vector<bignum>& seq) {
+    InverseTransform t;
+    for (const auto& b : seq)
+	t.push(b);
+    return t.result();
+}
+
+std::vector<bignum> exponentialTransform(const std::vector<bignum>& seq) {
+    ExponentialTransform t;
+    for (const auto& a : seq)
+	t.push(a);
+    return t.result();
+}
+
+std::vector<bignum> blockTransform(const std::vector<bignum>& seq) {
+    BlockTransform t;
+    for (const auto& a : seq)
+	t.push(a);
+    return t.result();
+}
+
+static int gcd(int a, int b) {
+    while (b) {
+	int t = a % b;
+	a = b;
+	b = t;
+    }
+    return a;
+}
+
+// Burnside over the permutations of the vertices, grouped by cycle
+// type: a permutation with c_k cycles of length k fixes 2^e graphs,
+// with e the number of edge orbits
+//   e = sum_k (c_k floor(k/2) + k binom(c_k, 2)) + sum_{i<j} c_i c_j gcd(i, j),
+// and there are n!/z permutations of this type, z = prod_k k^c_k c_k!.
+// The class size n!/z is divided down as the parts are chosen.
+static void sumCycleTypes(int n, int maxPart, int e, const bignum& classSize,
+			  std::vector<std::pair<int, int>>& parts, bignum& sum) {
+    if (n == 0) {
+	sum += classSize << e;
+	return;
+    }
+    for (int k = std::min(n, maxPart); k >= 1; --k) {
+	int crossPerCycle = 0;
+	for (const auto& p : parts)
+	    crossPerCycle += p.second * gcd(k, p.first);
+	bignum size = classSize;
+	for (int c = 1; c * k <= n; ++c) {
+	    mpz_divexact_ui(size.get_mpz_t(), size.get_mpz_t(), k * c);
+	    int ek = e + c * (k / 2) + k * (c * (c - 1) / 2) + c * crossPerCycle;
+	    parts.push_back({k, c});
+	    sumCycleTypes(n - c * k, k - 1, ek, size, parts, sum);
+	    parts.pop_back();
+	}
+    }
+}
+
+static bignum computeNumGraphs(int n) {
+    bignum nFactorial = 1;
+    for (int i = 2; i <= n; ++i)
+	nFactorial *= i;
+    bignum sum = 0;
+    std::vector<std::pair<int, int>> parts;
+    sumCycleTypes(n, n, 0, nFactorial, parts, sum);
+    assert(sum % nFactorial == 0);
+    return sum / nFactorial;
+}
+
+// https://oeis.org/A000088
+bignum numGraphs(int n) {
+    static std::vector<bignum> memo;
+    while (int(memo.size()) <= n)
+	memo.push_back(computeNumGraphs(memo.size()));
+    return memo[n];
+}
+
 // https://oeis.org/A001349
-const std::vector<bignum> numConnectedGraphs = {
-    1_mpz,
-    1_mpz,
-    1_mpz,
-    2_mpz,
-    6_mpz,
-    21_mpz,
-    112_mpz,
-    853_mpz,
-    11117_mpz,
-    261080_mpz,
-    11716571_mpz,
-    1006700565_mpz,
-    164059830476_mpz,
-    50335907869219_mpz,
-    29003487462848061_mpz,
-    31397381142761241960_mpz,
-    63969560113225176176277_mpz,
-    245871831682084026519528568_mpz,
-    1787331725248899088890200576580_mpz,
-    24636021429399867655322650759681644_mpz,
-    645465483198722799426731128794502283004_mpz,
-    32219627385046589818232044119082157323436797_mpz,
-    3070814262175729723895568454399186829509550171755_mpz,
-    559943868821088067965169467298102645124904586852569700_mpz,
-    195704346352067869424144939394112759539046378875336729014803_mpz,
-    131331197864429267343038461571121231901357546349778703464744110480_mpz,
-    169487487069103860309498044496181634419481050608589608741506974117661153_mpz,
-    421259837031894153474761394722982198262661349959958867827522253208309529657428_mpz,
-    2019295578418395388334710354184231114050311766824615116653385182748332016100781822978_mpz,
-    18691350703182535102936037539278223408795964939210324175289556058530041603266454027210155407_mpz,
-    334494297617902927474062588988771420592400340448497175735486787573919763092664433461017585013705594_mpz,
-};
+bignum numConnectedGraphs(int n) {
+    static InverseTransform memo;
+    while (int(memo.result().size()) <= n)
+	memo.push(numGraphs(memo.result().size()));
+    return memo.result()[n];
+}
 
 std::vector<bignum> nonGraphs(const std::vector<bignum>& seq) {
-    // https://oeis.org/A000088
-    static std::vector<bignum> numGraphs = transform(numConnectedGraphs);
-    if (seq.size() > numGraphs.size())
-	throw std::domain_error("need more data in EulerTransform::nonGraphs");
     std::vector<bignum> result(seq.size());
     for (size_t i = 0; i < seq.size(); ++i)
-	result[i] = numGraphs[i] - seq[i];
+	result[i] = numGraphs(i) - seq[i];
     return result;
 }
 
@@ -151,11 +252,9 @@ std::vector<bignum> nonGraphs(const std::vector<uint64_t>& s) {
 }
 
 std::vector<bignum> connectedNonGraphs(const std::vector<bignum>& seq) {
-    if (seq.size() > numConnectedGraphs.size())
-	throw std::domain_error("need more data in EulerTransform::connectedNonGraphs");
     std::vector<bignum> result(seq.size());
     for (size_t i = 0; i < seq.size(); ++i)
-	result[i] = numConnectedGraphs[i] - seq[i];
+	result[i] = numConnectedGraphs(i) - seq[i];
     return result;
 }
 
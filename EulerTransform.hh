@@ -26,8 +26,70 @@ namespace EulerTransform {
 
 typedef mpz_class bignum;
 
+// The Euler transform b of a, that is, b_n is the number of multisets
+// of total size n of objects where a_k objects have size k; e.g.,
+// graphs from connected graphs. a_0 is ignored and b_0 = 1. Terms are
+// added one at a time, each in O(n) bignum operations.
+class Transform {
+public:
+    // append the next a_n and return b_n
+    const bignum& push(const bignum& a);
+    const std::vector<bignum>& result() const { return b_; }
+private:
+    std::vector<bignum> a_, b_, c_;
+};
+
+// recovers a from b, taking a_0 = b_0
+class InverseTransform {
+public:
+    // append the next b_n and return a_n
+    const bignum& push(const bignum& b);
+    const std::vector<bignum>& result() const { return a_; }
+private:
+    std::vector<bignum> a_, b_, c_;
+};
+
+// The labeled counterpart (exponential transform): b_n is the number
+// of sets of labeled objects with n labels in total, e.g., labeled
+// graphs from labeled connected graphs. a_0 is ignored and b_0 = 1.
+class ExponentialTransform {
+public:
+    // append the next a_n and return b_n
+    const bignum& push(const bignum& a);
+    const std::vector<bignum>& result() const { return b_; }
+private:
+    std::vector<bignum> a_, b_;
+};
+
+// Labeled connected graphs from labeled blocks (K2 and biconnected
+// graphs): a connected graph rooted at a vertex is the root together
+// with a set of blocks through it, each with a rooted connected graph
+// hanging off its other vertices, so with C' = exp(B'(x C')) for the
+// exponential generating functions. a_0 and a_1 are ignored and
+// b_0 = b_1 = 1.
+class BlockTransform {
+public:
+    // append the next a_n and return b_n
+    const bignum& push(const bignum& a);
+    const std::vector<bignum>& result() const { return b_; }
+private:
+    // the rooted graphs r_ = x C' and the powers p_[k] = r^k/k!, as
+    // exponential generating functions; exp_ is fed B'(r)
+    std::vector<bignum> a_, b_, r_;
+    std::vector<std::vector<bignum>> p_;
+    ExponentialTransform exp_;
+};
+
 std::vector<bignum> transform(const std::vector<uint64_t>& seq);
 std::vector<bignum> transform(const std::vector<bignum>& seq);
+std::vector<bignum> inverseTransform(const std::vector<bignum>& seq);
+std::vector<bignum> exponentialTransform(const std::vector<bignum>& seq);
+std::vector<bignum> blockTransform(const std::vector<bignum>& seq);
+// number of unlabeled (connected) graphs on n vertices, for any n;
+// computed on first use and then remembered
+bignum numGraphs(int n);
+bignum numConnectedGraphs(int n);
+
 std::vector<bignum> nonGraphs(const std::vector<uint64_t>& seq);
 std::vector<bignum> nonGraphs(const std::vector<bignum>& seq);
 std::vector<bignum> connectedNonGraphs(const std::vector<uint64_t>& seq);
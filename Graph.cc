@@ -16,58 +16,45 @@
    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
 
 #include "Graph.hh"
+#include "NamedGraphs.hh"
 
 #include "nauty/nauty.h"
 
 #include <algorithm>
-#include <map>
 #include <numeric>
 
-// A&BvC: an A graph with an extra B vertices, each of which is attached to C vertices of the A
-static const std::map<std::string, Graph> namedGraphs = {
-    {"empty",   Graph(0).canonical()},
-    {"triangle",Graph::ofGraph6("Bw").canonical()},
-    {"diamond", Graph::ofGraph6("Cz").canonical()},
-    {"paw",     Graph::ofGraph6("Cx").canonical()},
-    {"claw",    Graph::ofGraph6("Cs").canonical()},
-    {"K5-e",    Graph::ofGraph6("D~k").canonical()},
-    {"K4&v2",   Graph::ofGraph6("DN{").canonical()},
-    {"W4",      Graph::ofGraph6("Dl{").canonical()},
-    {"K4&v1",   Graph::ofGraph6("DJ{").canonical()},
-    {"C4&v3",   Graph::ofGraph6("D]w").canonical()},
-    {"gem",     Graph::ofGraph6("Dh{").canonical()},
-    {"K2&3v2",  Graph::ofGraph6("DF{").canonical()},
-    {"bowtie",  Graph::ofGraph6("D{c").canonical()},
-    {"fork",    Graph::ofGraph6("DiC").canonical()},
-    {"kite",    Graph::ofGraph6("DTw").canonical()},
-    {"dart",    Graph::ofGraph6("DvC").canonical()},
-    {"house",   Graph::ofGraph6("DUw").canonical()},
-    {"banner",  Graph::ofGraph6("DrG").canonical()},
-    {"tadpole", Graph::ofGraph6("DKs").canonical()},
-    {"necktie", Graph::ofGraph6("DKs").canonical()},
-    {"bull",    Graph::ofGraph6("D{O").canonical()},
-    {"cricket", Graph::ofGraph6("DiS").canonical()},
-    {"R",       Graph::ofGraph6("ElCO").canonical()},
-    {"domino",  Graph::ofGraph6("ErGW").canonical()},
-    {"P6-comp", Graph::ofGraph6("EUzo").canonical()},
-};
-
 Graph Graph::ofNauty(word* nautyg, int n) {
     Graph g(n);
-    for (int i = 0; i < n; ++i)
-	g.neighbors_[i] = Set::ofBits(reverseBits(nautyg[i]));
+    g.assignNauty(nautyg, n);
     return g;
 }
 
+void Graph::assignNauty(const word* nautyg, int n) {
+    assert(n >= 0 && n <= maxn());
+    for (int i = n; i < n_; ++i)
+	neighbors_[i] = Set();
+    n_ = n;
+    for (int i = 0; i < n; ++i)
+	neighbors_[i] = Set::ofNauty(&nautyg[i], 1);
+}
+
 Graph Graph::ofGraph6(std::string g6) {
     for (size_t i = 0; i < g6.size(); ++i)
         g6[i] -= 63;
     int n = g6[0];
+    int start = 1;
+    // n >= 63 takes three more bytes
+    if (n == 63) {
+	n = (g6[1] << 12) | (g6[2] << 6) | g6[3];
+	start = 4;
+    }
+    if (n > maxn())
+	throw std::invalid_argument("Graph::ofGraph6: graph too large");
     Graph g(n);
     int b = 0;
     for (int j = 0 ; j < n; ++j) {
         for (int i = 0; i < j; ++i) {
-            int byte = 1 + (b / 6);
+            int byte = start + (b / 6);
             int bit = 5 - (b % 6);
             if ((g6[byte] >> bit) & 1)
                 g.addEdge(i, j);
@@ -79,9 +66,12 @@ Graph Graph::ofGraph6(std::string g6) {
 
 Graph Graph::byName(std::string name) {
     // claw, paw etc.
-    auto p = namedGraphs.find(name);
-    if (p != namedGraphs.end())
-	return p->second;
+    auto p = std::lower_bound(namedGraphs, namedGraphs + numNamedGraphs, name,
+			      [](const NamedGraph& ng, const std::string& name) {
+				  return name.compare(ng.name) > 0;
+			      });
+    if (p != namedGraphs + numNamedGraphs && name == p->name)
+	return ofGraph6(p->graph6);
 
     auto stoi = [](const std::string& s) -> int {
 	int r = 0;
@@ -107,8 +97,9 @@ Graph Graph::byName(std::string name) {
 	Graph g(n);
 	for (int u = 0; u < g1.n(); ++u)
 	    g.neighbors_[u] = g1.neighbors_[u];
-	for (int u = 0; u < g2.n(); ++u)
-	    g.neighbors_[g1.n() + u] = Set::ofBits(g2.neighbors_[u].bits() << g1.n());
+	// up to n <= maxn(), so that -Warray-bounds sees the rows exist
+	for (int u = g1.n(); u < n; ++u)
+	    g.neighbors_[u] = g2.neighbors_[u - g1.n()].shifted(g1.n());
 	return g;
     }
     auto DIGITS = "0123456789";
@@ -192,33 +183,58 @@ extern "C" {
     int geng_prune(word* nautyg, int n, int maxn);
 }
 
+// geng keeps its state in globals, so there can be only one
+// enumeration per process; the hooks find their callbacks here. The
+// graphs are passed in a buffer owned by the enumeration, so the
+// hooks don't touch the heap.
+struct Enumeration {
+    Enumeration(Graph::EnumerateHook f, void* fContext, Graph::PruneHook p, void* pContext)
+	: f(f), fContext(fContext), p(p), pContext(pContext), g(0) { }
+    Graph::EnumerateHook f;
+    void* fContext;
+    Graph::PruneHook p;
+    void* pContext;
+    Graph g;
+};
+static Enumeration* currentEnumeration = nullptr;
+
 void geng_outproc(FILE*, word* nautyg, int n) {
-    Graph g = Graph::ofNauty(nautyg, n);
-    Graph::enumerateCallback()(g);
+    Enumeration* e = currentEnumeration;
+    e->g.assignNauty(nautyg, n);
+    e->f(e->fContext, e->g);
 }
 
 int geng_prune(word* nautyg, int n, int /*maxn*/) {
-    if (!Graph::pruneCallback())
+    Enumeration* e = currentEnumeration;
+    if (!e->p)
 	return false;
-    Graph g = Graph::ofNauty(nautyg, n);
-    return Graph::pruneCallback()(g);
+    e->g.assignNauty(nautyg, n);
+    return e->p(e->pContext, e->g);
+}
+
+// nauty's dense format, with m setwords per vertex
+static int toNauty(const Graph& g, word* nautyg) {
+    int m = SETWORDSNEEDED(std::max(g.n(), 1));
+    for (int i = 0; i < g.n(); ++i)
+	g.neighbors(i).toNauty(&nautyg[i * m], m);
+    return m;
 }
 
 Graph Graph::canonical() const {
-    word nautyg[n()];
-    for (int i = 0; i < n(); ++i)
-	nautyg[i] = reverseBits(neighbors(i).bits());
+    int m = SETWORDSNEEDED(std::max(n(), 1));
+    word nautyg[n() * m];
+    toNauty(*this, nautyg);
     int orbits[n()];
     DEFAULTOPTIONS_GRAPH(options);
     options.getcanon = true;
     int lab[n()];
     int ptn[n()];
     statsblk stats;
-    word canonical[n()];
-    densenauty(nautyg, lab, ptn, orbits, &options, &stats, 1, n(), canonical);
+    word canonical[n() * m];
+    densenauty(nautyg, lab, ptn, orbits, &options, &stats, m, n(), canonical);
     Graph g(n());
     for (int i = 0; i < n(); ++i)
-	g.neighbors_[i] = Set::ofBits(reverseBits(canonical[i]));
+	g.neighbors_[i] = Set::ofNauty(&canonical[i * m], m);
     return g;
 }
 
@@ -235,12 +251,41 @@ void groupsize(int* /*lab*/, int* /*ptn*/, int /*level*/, int* /*orbits*/, stats
     grpsize *= index;
 }
 
+static uint128 grpsize128;
+void groupsize128(int* /*lab*/, int* /*ptn*/, int /*level*/, int* /*orbits*/, statsblk* /*stats*/,
+		  int /*tv*/, int index, int /*tcellsize*/, int /*numcells*/, int /*cc*/, int /*n*/) {
+    grpsize128 *= index;
+}
+
+uint128 Graph::numLabeledGraphs128() const {
+    assert(n() <= MAX_N_LABELED_128);
+    static const std::array<uint128, MAX_N_LABELED_128 + 1> factorials = [] {
+	std::array<uint128, MAX_N_LABELED_128 + 1> f;
+	f[0] = 1;
+	for (int i = 1; i <= MAX_N_LABELED_128; ++i)
+	    f[i] = f[i - 1] * i;
+	return f;
+    }();
+    if (n() == 0)
+	return 1;
+    word nautyg[n() * SETWORDSNEEDED(n())];
+    int m = toNauty(*this, nautyg);
+    int orbits[n()];
+    DEFAULTOPTIONS_GRAPH(options);
+    options.userlevelproc = groupsize128;
+    grpsize128 = 1;
+    int lab[n()];
+    int ptn[n()];
+    statsblk stats;
+    densenauty(nautyg, lab, ptn, orbits, &options, &stats, m, n(), nullptr);
+    return factorials[n()] / grpsize128;
+}
+
 bignum Graph::numLabeledGraphs() const {
     if (n() == 0)
 	return 1;
-    word nautyg[n()];
-    for (int i = 0; i < n(); ++i)
-	nautyg[i] = reverseBits(neighbors(i).bits());
+    word nautyg[n() * SETWORDSNEEDED(n())];
+    int m = toNauty(*this, nautyg);
     int orbits[n()];
     DEFAULTOPTIONS_GRAPH(options);
     options.userlevelproc = groupsize;
@@ -249,22 +294,164 @@ bignum Graph::numLabeledGraphs() const {
     int lab[n()];
     int ptn[n()];
     statsblk stats;
-    word canonical[n()];
-    densenauty(nautyg, lab, ptn, orbits, &options, &stats, 1, n(), canonical);
+    word canonical[n() * m];
+    densenauty(nautyg, lab, ptn, orbits, &options, &stats, m, n(), canonical);
     if (stats.grpsize1 <= (uint64_t(1) << 53) && stats.grpsize2 == 0)
 	assert(stats.grpsize1 == grpsize);
     return factorial(n()) / grpsize;
 }
 
-void Graph::doEnumerate(int n, EnumerateCallback f, PruneCallback p, int flags) {
-    if (enumerateCallback_)
+// Free trees as level sequences (depth of each vertex in preorder),
+// following Wright, Richmond, Odlyzko and McKay, "Constant time
+// generation of free trees", SIAM J. Comput. 15 (1986).
+struct LevelSequence {
+    int n;
+    int level[MAXN];
+};
+
+// next rooted tree in reverse lexicographic order, changing positions
+// p and above; false if there is none
+static bool nextRootedTree(LevelSequence& t, int p = -1) {
+    if (p < 0) {
+	p = t.n - 1;
+	while (t.level[p] == 1)
+	    --p;
+    }
+    if (p == 0)
+	return false;
+    int q = p - 1;
+    while (t.level[q] != t.level[p] - 1)
+	--q;
+    for (int i = p; i < t.n; ++i)
+	t.level[i] = t.level[i - p + q];
+    return true;
+}
+
+// length of the first subtree of the root (plus the root), and
+// heights of it and of the rest
+static int splitTree(const LevelSequence& t, int& leftHeight, int& restHeight) {
+    int m = 2;
+    while (m < t.n && t.level[m] != 1)
+	++m;
+    leftHeight = restHeight = 0;
+    for (int i = 1; i < m; ++i)
+	leftHeight = std::max(leftHeight, t.level[i] - 1);
+    for (int i = m; i < t.n; ++i)
+	restHeight = std::max(restHeight, t.level[i]);
+    return m;
+}
+
+// turn t into the next sequence that is the canonical rooting of a
+// free tree (rooted at a center, largest subtree first)
+static bool nextFreeTree(LevelSequence& t) {
+    int leftHeight, restHeight;
+    int m = splitTree(t, leftHeight, restHeight);
+    bool valid = restHeight >= leftHeight;
+    if (valid && restHeight == leftHeight) {
+	int leftLength = m - 1, restLength = t.n - m + 1;
+	if (leftLength > restLength) {
+	    valid = false;
+	} else if (leftLength == restLength) {
+	    // compare left and rest (which starts with the root at level 0)
+	    for (int i = 0; i < leftLength; ++i) {
+		int l = t.level[1 + i] - 1;
+		int r = i == 0 ? 0 : t.level[m + i - 1];
+		if (l != r) {
+		    valid = l < r;
+		    break;
+		}
+	    }
+	}
+    }
+    if (valid)
+	return true;
+    int p = m - 1;
+    bool deep = t.level[p] > 2;
+    if (!nextRootedTree(t, p))
+	return false;
+    if (deep) {
+	splitTree(t, leftHeight, restHeight);
+	for (int i = 0; i < leftHeight + 1; ++i)
+	    t.level[t.n - leftHeight - 1 + i] = i + 1;
+    }
+    return true;
+}
+
+static void assignTree(Graph& g, const LevelSequence& t) {
+    int stack[MAXN];
+    int top = 0;
+    for (int i = 0; i < t.n; ++i) {
+	while (top > 0 && t.level[stack[top - 1]] >= t.level[i])
+	    --top;
+	if (top > 0)
+	    g.addEdge(stack[top - 1], i);
+	stack[top++] = i;
+    }
+}
+
+static bool satisfiesBounds(const Graph& g, const Graph::Bounds& bounds) {
+    for (int u = 0; u < g.n(); ++u)
+	if ((bounds.minDeg >= 0 && g.deg(u) < bounds.minDeg)
+	    || (bounds.maxDeg >= 0 && g.deg(u) > bounds.maxDeg))
+	    return false;
+    int m = g.n() - 1;
+    return (bounds.minEdges < 0 || m >= bounds.minEdges)
+	&& (bounds.maxEdges < 0 || m <= bounds.maxEdges);
+}
+
+void Graph::enumerateTrees(int n, EnumerateHook f, void* fContext, const Bounds& bounds,
+			   int res, int mod) {
+    Graph g(n);
+    // there are more than 2^31 trees from n = 29 on
+    uint64_t index = 0;
+    if (n <= 2) {
+	if (n == 2)
+	    g.addEdge(0, 1);
+	if (res == 0 && satisfiesBounds(g, bounds))
+	    f(fContext, g);
+	return;
+    }
+    LevelSequence t;
+    t.n = n;
+    // path rooted at its center
+    int i = 0;
+    for (int l = 0; l <= n / 2; ++l)
+	t.level[i++] = l;
+    for (int l = 1; l < (n + 1) / 2; ++l)
+	t.level[i++] = l;
+    while (nextFreeTree(t)) {
+	if (index++ % mod == uint64_t(res)) {
+	    g = Graph(n);
+	    assignTree(g, t);
+	    if (satisfiesBounds(g, bounds))
+		f(fContext, g);
+	}
+	if (!nextRootedTree(t))
+	    break;
+    }
+}
+
+void Graph::doEnumerate(int n, EnumerateHook f, void* fContext, PruneHook p, void* pContext,
+			int flags, const Bounds& bounds, int res, int mod) {
+    if (currentEnumeration)
 	throw std::runtime_error("generating graphs is not reentrant");
+    if (mod < 1 || res < 0 || res >= mod)
+	throw std::invalid_argument("Graph::enumeratePart: invalid res/mod");
     if (n == 0) {
-	f(Graph(0));
+	if (res == 0 && bounds.minEdges <= 0)
+	    f(fContext, Graph(0));
 	return;
     }
-    enumerateCallback_ = f;
-    pruneCallback_ = p;
+    // every tree is triangle-free, square-free, bipartite, K4-free,
+    // chordal and perfect; other filters are left to geng
+    if ((flags & TREE) && !(flags & (BICONNECTED | SPLIT | CLAW_FREE))) {
+	enumerateTrees(n, f, fContext, bounds, res, mod);
+	return;
+    }
+    if (n > WORDSIZE)
+	throw std::invalid_argument("Graph::enumerate: geng only generates graphs on up to "
+				    + std::to_string(WORDSIZE) + " vertices");
+    Enumeration enumeration(f, fContext, p, pContext);
     std::vector<const char*> argv = {"geng", "-q"};
     if (flags & CONNECTED)     argv.push_back("-c");
     if (flags & TREE)          argv.push_back("-c");
@@ -272,27 +459,55 @@ void Graph::doEnumerate(int n, EnumerateCallback f, PruneCallback p, int flags)
     if (flags & TRIANGLE_FREE) argv.push_back("-t");
     if (flags & SQUARE_FREE)   argv.push_back("-f");
     if (flags & BIPARTITE)     argv.push_back("-b");
+    if (flags & K4_FREE)       argv.push_back("-k");
+    if (flags & CHORDAL)       argv.push_back("-T");
+    if (flags & SPLIT)         argv.push_back("-S");
+    if (flags & PERFECT)       argv.push_back("-P");
+    if (flags & CLAW_FREE)     argv.push_back("-F");
+    std::string sMinDeg = "-d" + std::to_string(bounds.minDeg);
+    std::string sMaxDeg = "-D" + std::to_string(bounds.maxDeg);
+    if (bounds.minDeg >= 0)
+	argv.push_back(sMinDeg.c_str());
+    if (bounds.maxDeg >= 0)
+	argv.push_back(sMaxDeg.c_str());
+    int minEdges = bounds.minEdges, maxEdges = bounds.maxEdges;
+    if (flags & TREE) {
+	minEdges = std::max(minEdges, n - 1);
+	maxEdges = maxEdges >= 0 ? std::min(maxEdges, n - 1) : n - 1;
+    }
+    if (maxEdges >= 0 && maxEdges < std::max(minEdges, 0))
+	return;
     std::string sn = std::to_string(n);
-    std::string sm = std::to_string(n - 1) + ':' + std::to_string(n - 1);
+    std::string sm = std::to_string(std::max(minEdges, 0)) + ':'
+	+ std::to_string(maxEdges >= 0 ? maxEdges : n * (n - 1) / 2);
+    std::string sresmod = std::to_string(res) + '/' + std::to_string(mod);
     argv.push_back(sn.c_str());
-    if (flags & TREE)
+    if (minEdges >= 0 || maxEdges >= 0)
 	argv.push_back(sm.c_str());
+    if (mod > 1)
+	argv.push_back(sresmod.c_str());
     argv.push_back(nullptr);
+    currentEnumeration = &enumeration;
     geng_main(argv.size() - 1, const_cast<char**>(argv.data()));
-    enumerateCallback_ = nullptr;
-    pruneCallback_ = nullptr;
+    currentEnumeration = nullptr;
 }
 
-void Graph::enumerate(int n, EnumerateCallback f, int flags) {
-    doEnumerate(n, f, nullptr, flags);
+void Graph::enumerate(int n, EnumerateCallback f, int flags, const Bounds& bounds) {
+    enumeratePart(n, 0, 1, f, nullptr, flags, bounds);
 }
 
-void Graph::enumerate(int n, EnumerateCallback f, PruneCallback p, int flags) {
-    doEnumerate(n, f, p, flags);
+void Graph::enumerate(int n, EnumerateCallback f, PruneCallback p, int flags,
+		      const Bounds& bounds) {
+    enumeratePart(n, 0, 1, f, p, flags, bounds);
 }
 
-Graph::EnumerateCallback Graph::enumerateCallback_;
-Graph::PruneCallback Graph::pruneCallback_;
+void Graph::enumeratePart(int n, int res, int mod, EnumerateCallback f, PruneCallback p, int flags,
+			  const Bounds& bounds) {
+    if (p)
+	enumeratePart<EnumerateCallback, PruneCallback>(n, res, mod, f, p, flags, bounds);
+    else
+	enumeratePart<EnumerateCallback>(n, res, mod, f, nullptr, flags, bounds);
+}
 
 // Bron--Kerbosch
 void extendCliques(const Graph& g, std::function<void(Set)> f,
@@ -323,16 +538,18 @@ void Graph::maximalCliques(std::function<void(Set)> f) const {
 }
 
 static std::string connectedGraphName(Graph g) {
-    Graph gCanon = g.canonical();
-    for (auto p : namedGraphs) {
-	if (p.second == gCanon)
-	    return p.first;
-    }
+    std::string g6 = g.canonical().graph6();
+    // the first of several names for the same graph
+    auto p = std::lower_bound(namedGraphsByGraph6, namedGraphsByGraph6 + numNamedGraphs, g6,
+			      [](const NamedGraph& ng, const std::string& g6) {
+				  return g6.compare(ng.graph6) > 0;
+			      });
+    if (p != namedGraphsByGraph6 + numNamedGraphs && g6 == p->graph6)
+	return p->name;
 
     int n = g.n();
-    int degs[n];
-    for (int u = 0; u < n; ++u)
-	degs[u] = g.deg(u);
+    int degs[MAXN];
+    Rows::popcounts(g.neighbors(), n, g.vertices(), degs);
     std::sort(degs, degs + n);
     if (degs[0] == n - 1 && degs[n - 1] == n - 1)
 	return std::string("K") + std::to_string(n);
@@ -344,8 +561,7 @@ static std::string connectedGraphName(Graph g) {
     }
     Graph gComplement = g.complement();
     if (gComplement.isConnected()) {
-	for (int u = 0; u < n; ++u)
-	    degs[u] = gComplement.deg(u);
+	Rows::popcounts(gComplement.neighbors(), n, gComplement.vertices(), degs);
 	std::sort(degs, degs + n);
 	if (degs[n - 1] == 2) {
 	    if (degs[0] == 1)
@@ -426,7 +642,14 @@ std::string Graph::toString() const {
 
 std::string Graph::graph6() const {
     std::string s;
-    s += n() + 63;
+    if (n() < 63) {
+	s += n() + 63;
+    } else {
+	s += 126;
+	s += (n() >> 12) + 63;
+	s += ((n() >> 6) & 63) + 63;
+	s += (n() & 63) + 63;
+    }
     int k = 6;
     int x = 0;
     for (int j = 1; j < n(); ++j) {
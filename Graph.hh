@@ -18,15 +18,21 @@
 #ifndef TINYGRAPH_GRAPH_HH_INCLUDED
 #define TINYGRAPH_GRAPH_HH_INCLUDED
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <functional>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 #include <gmpxx.h>
 
+#include "Rows.hh"
 #include "Set.hh"
 
 using bignum = mpz_class;
+using uint128 = unsigned __int128;
 
 struct Edge {
     Edge() { }
@@ -51,25 +57,26 @@ struct Edge {
 
 class Graph {
 public:
-    explicit Graph(int n, std::initializer_list<std::pair<int, int>> es = {}) : neighbors_(n) {
+    explicit Graph(int n, std::initializer_list<std::pair<int, int>> es = {}) : n_(n), neighbors_() {
 	assert(n >= 0 && n <= maxn());
 	for (auto e : es)
 	    addEdge(e.first, e.second);
     }
 
+    // nauty graphs with one setword per vertex, as from geng
     static Graph ofNauty(word* g, int n);
+    // overwrite with a nauty graph on n vertices
+    void assignNauty(const word* g, int n);
     static Graph byName(std::string name);
     static Graph ofGraph6(std::string g6);
 
     static Graph cycle(int n);
 
-    int n() const { return neighbors_.size(); }
+    int n() const { return n_; }
     static constexpr int maxn() { return Set::MAX_ELEMENT + 1; }
     Set vertices() const { return Set::ofRange(n()); }
     int m() const {
-	int m = 0;
-	for (int u = 0; u < n(); ++u)
-	    m += deg(u);
+	int m = Rows::popcount(neighbors(), n());
 	assert((m % 2) == 0);
 	return m / 2;
     }
@@ -80,8 +87,10 @@ public:
     bool hasEdge(int u, int v) const { return neighbors(u).contains(v); }
     bool isConnected() const;
 
-    bool operator==(const Graph& g) const { return neighbors_ == g.neighbors_; }
-    bool operator!=(const Graph& g) const { return neighbors_ != g.neighbors_; }
+    bool operator==(const Graph& g) const {
+	return n_ == g.n_ && std::equal(neighbors_.begin(), neighbors_.begin() + n_, g.neighbors_.begin());
+    }
+    bool operator!=(const Graph& g) const { return !(*this == g); }
 
     void addEdge(int u, int v) {
 	assert(u >= 0 && u < n());
@@ -108,9 +117,9 @@ public:
 	for (int v = 0; v < n(); ++v) {
 	    if (v == u)
 		continue;
-	    neighbors_[i++] = Set::ofBits(delbit(neighbors(v).bits(), u));
+	    neighbors_[i++] = neighbors(v).deleted(u);
 	}
-	neighbors_.pop_back();
+	neighbors_[--n_] = Set();
     }
 
     class Edges {
@@ -196,17 +205,35 @@ public:
     ConnectedComponents connectedComponents() const { return ConnectedComponents(*this); }
 
     int mSubgraph(Set vs) const {
-	int m = 0;
-	for (int u : vs)
-	    m += (neighbors(u) & vs).size();
+	int m = Rows::popcountMasked(neighbors(), n(), vs);
 	assert((m % 2) == 0);
 	return m / 2;
     }
 
+    // the number of edges in the subgraph induced by a vertex set that
+    // changes by one vertex at a time, updated by a popcount per change
+    class InducedEdges {
+    public:
+	InducedEdges(const Graph& g, Set vs = {}) : g_(g), vs_(vs), m_(g.mSubgraph(vs)) { }
+	void add(int u) { m_ += (g_.neighbors(u) & vs_).size(); vs_.add(u); }
+	void remove(int u) { vs_.remove(u); m_ -= (g_.neighbors(u) & vs_).size(); }
+	void toggle(int u) {
+	    if (vs_.contains(u))
+		remove(u);
+	    else
+		add(u);
+	}
+	Set vertices() const { return vs_; }
+	int m() const { return m_; }
+    private:
+	const Graph& g_;
+	Set vs_;
+	int m_;
+    };
+
     Graph complement() const {
 	Graph g(n());
-	for (int u = 0; u < n(); ++u)
-	    g.neighbors_[u] = vertices() - neighbors(u) - u;
+	Rows::complement(neighbors(), n(), g.neighbors_.data());
 	return g;
     }
 
@@ -214,7 +241,7 @@ public:
 	Graph g(vs.size());
 	int i = 0;
 	for (int u : vs)
-	    g.neighbors_[i++] = Set::ofBits(extractBits(neighbors(u).bits(), vs.bits()));
+	    g.neighbors_[i++] = neighbors(u).extract(vs);
 	return g;
     }
 
@@ -229,26 +256,86 @@ public:
 	SQUARE_FREE   = 1 << 3,
 	BIPARTITE     = 1 << 4,
 	TREE          = 1 << 5,
+	K4_FREE       = 1 << 6,
+	CHORDAL       = 1 << 7,
+	SPLIT         = 1 << 8,
+	PERFECT       = 1 << 9,
+	CLAW_FREE     = 1 << 10,
     };
-    static void enumerate(int n, EnumerateCallback f, int flags = 0);
-    static void enumerate(int n, EnumerateCallback f, PruneCallback p, int flags = 0);
-    static EnumerateCallback enumerateCallback() { return enumerateCallback_; }
-    static PruneCallback pruneCallback() { return pruneCallback_; }
+    // degree and edge number limits for geng's -d, -D and mine:maxe;
+    // -1 means no limit
+    struct Bounds {
+	Bounds() : minDeg(-1), maxDeg(-1), minEdges(-1), maxEdges(-1) { }
+	int minDeg, maxDeg;
+	int minEdges, maxEdges;
+    };
+    // The prune callback sees each intermediate graph as the graph it
+    // was extended from plus a new vertex n() - 1; graphs for which it
+    // returns true are not extended further. It is only a hint: trees
+    // come from a separate generator that does not call it.
+    static void enumerate(int n, EnumerateCallback f, int flags = 0,
+			  const Bounds& bounds = Bounds());
+    static void enumerate(int n, EnumerateCallback f, PruneCallback p, int flags = 0,
+			  const Bounds& bounds = Bounds());
+    // only generate part res of mod (0 <= res < mod), like geng's res/mod
+    static void enumeratePart(int n, int res, int mod, EnumerateCallback f,
+			      PruneCallback p = nullptr, int flags = 0,
+			      const Bounds& bounds = Bounds());
+
+    // The geng hooks call the callbacks through a plain function
+    // pointer, so functors passed to the templates below cost one
+    // indirect call per graph and are inlined into their hook.
+    typedef void (*EnumerateHook)(void* f, const Graph& g);
+    typedef bool (*PruneHook)(void* p, const Graph& g);
+    template<typename F>
+    static void enumerate(int n, F f, int flags = 0, const Bounds& bounds = Bounds()) {
+	enumeratePart(n, 0, 1, f, nullptr, flags, bounds);
+    }
+    template<typename F, typename P,
+	     typename = typename std::enable_if<!std::is_arithmetic<P>::value
+						&& !std::is_enum<P>::value>::type>
+    static void enumerate(int n, F f, P p, int flags = 0, const Bounds& bounds = Bounds()) {
+	enumeratePart(n, 0, 1, f, p, flags, bounds);
+    }
+    template<typename F>
+    static void enumeratePart(int n, int res, int mod, F f, std::nullptr_t = nullptr, int flags = 0,
+			      const Bounds& bounds = Bounds()) {
+	doEnumerate(n, &callEnumerate<F>, &f, nullptr, nullptr, flags, bounds, res, mod);
+    }
+    template<typename F, typename P>
+    static void enumeratePart(int n, int res, int mod, F f, P p, int flags = 0,
+			      const Bounds& bounds = Bounds()) {
+	doEnumerate(n, &callEnumerate<F>, &f, &callPrune<P>, &p, flags, bounds, res, mod);
+    }
 
     void maximalCliques(std::function<void(Set)> f) const;
     bignum numLabeledGraphs() const;
+    // largest n with n! < 2^128
+    static constexpr int MAX_N_LABELED_128 = 34;
+    // same without bignums, for n() <= MAX_N_LABELED_128
+    uint128 numLabeledGraphs128() const;
 
     std::string toString() const;
     std::string graph6() const;
     std::string name() const;
 
 private:
-    static void doEnumerate(int n, EnumerateCallback f, PruneCallback p, int flags);
-    std::vector<Set> neighbors_;
-    static EnumerateCallback enumerateCallback_;
-    static PruneCallback pruneCallback_;
+    template<typename F>
+    static void callEnumerate(void* f, const Graph& g) { (*static_cast<F*>(f))(g); }
+    template<typename P>
+    static bool callPrune(void* p, const Graph& g) { return (*static_cast<P*>(p))(g); }
+    static void doEnumerate(int n, EnumerateHook f, void* fContext, PruneHook p, void* pContext,
+			    int flags, const Bounds& bounds, int res, int mod);
+    static void enumerateTrees(int n, EnumerateHook f, void* fContext, const Bounds& bounds,
+			       int res, int mod);
+    // fixed capacity, so copying a graph is a plain memcpy; rows at
+    // n() and above are kept empty
+    int n_;
+    std::array<Set, MAXN> neighbors_;
 };
 
+static_assert(std::is_trivially_copyable<Graph>::value, "Graph should be trivially copyable");
+
 std::ostream& operator<<(std::ostream& out, const Graph& g);
 
 #endif  // TINYGRAPH_GRAPH_HH_INCLUDED
@@ -49,7 +49,7 @@ int diameter(const Graph& g) {
     return diameter;
 }
 
-// return value MAXN indicates disconnected graph
+// return value 0 indicates disconnected graph
 int radius(const Graph& g) {
     if (g.n() == 0)
 	return g.n();
@@ -58,7 +58,9 @@ int radius(const Graph& g) {
 	Set seen = {u};
 	Set layer = {u};
 	int d = 0;
-	for (; ; ++d) {
+	// stop once u cannot have a smaller eccentricity; the search from
+	// the first vertex always completes and detects disconnection
+	for (; d < radius; ++d) {
 	    Set nextLayer;
 	    for (int v : layer)
 		nextLayer |= g.neighbors(v);
@@ -68,9 +70,11 @@ int radius(const Graph& g) {
 	    seen |= nextLayer;
 	    layer = nextLayer;
 	}
-	if (seen != g.vertices())
-	    return 0;
-	radius = std::min(radius, d);
+	if (d < radius) {
+	    if (seen != g.vertices())
+		return 0;
+	    radius = d;
+	}
     }
     return radius;
 }
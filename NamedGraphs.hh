@@ -0,0 +1,36 @@
+/* tinygraph -- exploring graph conjectures on small graphs
+   Copyright (C) 2015  Falk Hüffner
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
+
+#ifndef TINYGRAPH_NAMEDGRAPHS_HH_INCLUDED
+#define TINYGRAPH_NAMEDGRAPHS_HH_INCLUDED
+
+// The graphs from NamedGraphs.def with the graph6 of their canonical
+// forms. The tables are generated at build time by named-graphs into
+// NamedGraphs.cc, so that no canonical labeling runs at startup, and
+// are searched by binary search.
+struct NamedGraph {
+    const char* name;
+    const char* graph6;
+};
+
+extern const int numNamedGraphs;
+// sorted by name
+extern const NamedGraph namedGraphs[];
+// sorted by graph6, and then by name
+extern const NamedGraph namedGraphsByGraph6[];
+
+#endif  // TINYGRAPH_NAMEDGRAPHS_HH_INCLUDED
@@ -0,0 +1,209 @@
+/* tinygraph -- exploring graph conjectures on small graphs
+   Copyright (C) 2015  Falk Hüffner
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
+
+#include "Parallel.hh"
+
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace Parallel {
+
+struct Worker {
+    pid_t pid;
+    int fd;
+    int res;
+    std::string result;
+};
+
+static Worker spawn(PartCallback part, int res, int mod) {
+    int fds[2];
+    if (pipe(fds) != 0)
+	throw std::runtime_error("Parallel::forEachPart: pipe failed");
+    // don't let the child repeat output buffered so far
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    pid_t pid = fork();
+    if (pid < 0) {
+	close(fds[0]);
+	close(fds[1]);
+	throw std::runtime_error("Parallel::forEachPart: fork failed");
+    }
+    if (pid == 0) {
+	close(fds[0]);
+	int status = 0;
+	try {
+	    std::string result = part(res, mod);
+	    const char* p = result.data();
+	    size_t left = result.size();
+	    while (left > 0) {
+		ssize_t written = write(fds[1], p, left);
+		if (written <= 0) {
+		    status = 1;
+		    break;
+		}
+		p += written;
+		left -= written;
+	    }
+	} catch (const std::exception& e) {
+	    std::cerr << "part " << res << '/' << mod << ": " << e.what() << std::endl;
+	    status = 1;
+	}
+	close(fds[1]);
+	std::cout.flush();
+	std::cerr.flush();
+	std::fflush(nullptr);
+	_exit(status);
+    }
+    close(fds[1]);
+    return {pid, fds[0], res, ""};
+}
+
+// kill the remaining workers and release their pipes and processes
+static void stopWorkers(std::vector<Worker>& workers) {
+    for (const Worker& w : workers) {
+	kill(w.pid, SIGKILL);
+	close(w.fd);
+	waitpid(w.pid, nullptr, 0);
+    }
+    workers.clear();
+}
+
+void forEachPart(int mod, int jobs, PartCallback part, MergeCallback merge) {
+    if (jobs <= 1 || mod <= 1) {
+	for (int res = 0; res < mod; ++res)
+	    merge(res, part(res, mod));
+	return;
+    }
+    std::vector<Worker> workers;
+    int next = 0;
+    try {
+	while (next < mod || !workers.empty()) {
+	    while (next < mod && int(workers.size()) < jobs)
+		workers.push_back(spawn(part, next++, mod));
+	    std::vector<pollfd> fds(workers.size());
+	    for (size_t i = 0; i < workers.size(); ++i)
+		fds[i] = {workers[i].fd, POLLIN, 0};
+	    if (poll(fds.data(), fds.size(), -1) < 0) {
+		if (errno == EINTR)
+		    continue;
+		throw std::runtime_error("Parallel::forEachPart: poll failed");
+	    }
+	    for (size_t i = workers.size(); i-- > 0; ) {
+		if (!fds[i].revents)
+		    continue;
+		Worker& w = workers[i];
+		char buf[4096];
+		ssize_t r = read(w.fd, buf, sizeof buf);
+		if (r > 0) {
+		    w.result.append(buf, r);
+		    continue;
+		}
+		if (r < 0) {
+		    if (errno == EINTR)
+			continue;
+		    throw std::runtime_error("Parallel::forEachPart: read failed");
+		}
+		Worker done = std::move(w);
+		workers.erase(workers.begin() + i);
+		close(done.fd);
+		int status = 0;
+		pid_t reaped;
+		while ((reaped = waitpid(done.pid, &status, 0)) < 0 && errno == EINTR)
+		    ;
+		if (reaped < 0)
+		    throw std::runtime_error("Parallel::forEachPart: waitpid failed");
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+		    throw std::runtime_error("Parallel::forEachPart: part " + std::to_string(done.res)
+					     + '/' + std::to_string(mod) + " failed");
+		merge(done.res, done.result);
+	    }
+	}
+    } catch (...) {
+	stopWorkers(workers);
+	throw;
+    }
+}
+
+std::string runProgram(const std::vector<std::string>& args) {
+    int fds[2];
+    if (pipe(fds) != 0)
+	throw std::runtime_error("Parallel::runProgram: pipe failed");
+    std::vector<char*> argv;
+    for (const auto& a : args)
+	argv.push_back(const_cast<char*>(a.c_str()));
+    argv.push_back(nullptr);
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    pid_t pid = fork();
+    if (pid < 0) {
+	close(fds[0]);
+	close(fds[1]);
+	throw std::runtime_error("Parallel::runProgram: fork failed");
+    }
+    if (pid == 0) {
+	close(fds[0]);
+	dup2(fds[1], STDOUT_FILENO);
+	close(fds[1]);
+	execvp(argv[0], argv.data());
+	_exit(127);
+    }
+    close(fds[1]);
+    std::string output;
+    char buf[4096];
+    ssize_t r;
+    while ((r = read(fds[0], buf, sizeof buf)) != 0) {
+	if (r > 0)
+	    output.append(buf, r);
+	else if (errno != EINTR)
+	    break;
+    }
+    close(fds[0]);
+    int status = 0;
+    pid_t reaped;
+    while ((reaped = waitpid(pid, &status, 0)) < 0 && errno == EINTR)
+	;
+    if (reaped < 0)
+	throw std::runtime_error("Parallel::runProgram: waitpid failed");
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+	throw std::runtime_error("Parallel::runProgram: " + args[0] + " failed");
+    return output;
+}
+
+double cpuTime() {
+    double t = 0;
+    for (int who : {RUSAGE_SELF, RUSAGE_CHILDREN}) {
+	rusage usage;
+	getrusage(who, &usage);
+	t += usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6;
+	t += usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6;
+    }
+    return t;
+}
+
+}  // namespace Parallel
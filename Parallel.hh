@@ -0,0 +1,46 @@
+/* tinygraph -- exploring graph conjectures on small graphs
+   Copyright (C) 2015  Falk Hüffner
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
+
+#ifndef TINYGRAPH_PARALLEL_HH_INCLUDED
+#define TINYGRAPH_PARALLEL_HH_INCLUDED
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Parallel {
+
+typedef std::function<std::string(int res, int mod)> PartCallback;
+typedef std::function<void(int res, const std::string& result)> MergeCallback;
+
+// Run part(res, mod) for res = 0, ..., mod - 1 in up to jobs worker
+// processes, handing out the next part whenever a worker finishes,
+// and pass each result to merge in the calling process. geng is not
+// reentrant, so the workers are forked processes rather than threads.
+void forEachPart(int mod, int jobs, PartCallback part, MergeCallback merge);
+
+// Run the program args[0], searched in PATH if it contains no '/',
+// with arguments args[1], ..., and return its standard output.
+// Throws std::runtime_error if it cannot be run or exits with failure.
+std::string runProgram(const std::vector<std::string>& args);
+
+// CPU time in seconds used by this process and its finished workers
+double cpuTime();
+
+}  // namespace Parallel
+
+#endif  // TINYGRAPH_PARALLEL_HH_INCLUDED
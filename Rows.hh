@@ -0,0 +1,193 @@
+/* tinygraph -- exploring graph conjectures on small graphs
+   Copyright (C) 2015  Falk Hüffner
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
+
+#ifndef TINYGRAPH_ROWS_HH_INCLUDED
+#define TINYGRAPH_ROWS_HH_INCLUDED
+
+#include <type_traits>
+
+#include "Set.hh"
+
+// Kernels over the rows of an adjacency matrix, that is, an array of
+// MAXN sets of which only the first n may be nonempty. With AVX2 and
+// one word per set, they handle 256 bits at a time; this touches the
+// rows up to n rounded up to a multiple of 256 / WORDSIZE, which are
+// inside the array and empty.
+
+#if defined(__AVX2__) && MAXN == WORDSIZE
+#define TINYGRAPH_AVX2
+#include <immintrin.h>
+#endif
+
+namespace Rows {
+
+#ifdef TINYGRAPH_AVX2
+static_assert(std::is_standard_layout<Set>::value && sizeof (Set) == sizeof (word),
+	      "rows must be plain word arrays");
+static_assert(MAXN * WORDSIZE % 256 == 0, "row array must be a multiple of 256 bits");
+
+static constexpr int LANES = 256 / WORDSIZE;
+
+inline int numBlocks(int n) { return (n + LANES - 1) / LANES; }
+
+inline __m256i load(const Set* rows, int b) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows) + b);
+}
+
+inline void store(Set* rows, int b, __m256i x) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(rows) + b, x);
+}
+
+#if WORDSIZE == 64
+inline __m256i broadcast(Set s) { return _mm256_set1_epi64x(s.bits()); }
+inline __m256i laneBits() { return _mm256_setr_epi64x(1, 2, 4, 8); }
+inline __m256i nextLaneBits(__m256i bits) { return _mm256_slli_epi64(bits, LANES); }
+inline __m256i equal(__m256i x, __m256i y) { return _mm256_cmpeq_epi64(x, y); }
+#elif WORDSIZE == 32
+inline __m256i broadcast(Set s) { return _mm256_set1_epi32(s.bits()); }
+inline __m256i laneBits() { return _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128); }
+inline __m256i nextLaneBits(__m256i bits) { return _mm256_slli_epi32(bits, LANES); }
+inline __m256i equal(__m256i x, __m256i y) { return _mm256_cmpeq_epi32(x, y); }
+#else // WORDSIZE == 16
+inline __m256i broadcast(Set s) { return _mm256_set1_epi16(s.bits()); }
+inline __m256i laneBits() {
+    return _mm256_setr_epi16(1 << 0, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6, 1 << 7,
+			     1 << 8, 1 << 9, 1 << 10, 1 << 11, 1 << 12, 1 << 13, 1 << 14,
+			     short(1 << 15));
+}
+inline __m256i nextLaneBits(__m256i) { return _mm256_setzero_si256(); }
+inline __m256i equal(__m256i x, __m256i y) { return _mm256_cmpeq_epi16(x, y); }
+#endif
+
+// all ones in the lanes of the rows contained in s, where bits holds
+// the bit of each lane's row
+inline __m256i selectRows(__m256i s, __m256i bits) {
+    return equal(_mm256_and_si256(s, bits), bits);
+}
+
+// number of set bits in each byte
+inline __m256i popcountBytes(__m256i x) {
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+					   0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(x, low));
+    __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(x, 4), low));
+    return _mm256_add_epi8(lo, hi);
+}
+
+// add the byte counts to four 64-bit sums
+inline __m256i accumulate(__m256i sums, __m256i byteCounts) {
+    return _mm256_add_epi64(sums, _mm256_sad_epu8(byteCounts, _mm256_setzero_si256()));
+}
+
+inline int total(__m256i sums) {
+    __m128i s = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+    return _mm_cvtsi128_si64(s) + _mm_extract_epi64(s, 1);
+}
+
+// store the popcount of each lane of x as ints
+inline void storePopcounts(int* counts, __m256i x) {
+    __m256i c = popcountBytes(x);
+#if WORDSIZE == 64
+    c = _mm256_sad_epu8(c, _mm256_setzero_si256());
+    c = _mm256_permutevar8x32_epi32(c, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(counts), _mm256_castsi256_si128(c));
+#else
+    c = _mm256_maddubs_epi16(c, _mm256_set1_epi8(1));
+#if WORDSIZE == 32
+    c = _mm256_madd_epi16(c, _mm256_set1_epi16(1));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(counts), c);
+#else
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(counts),
+			_mm256_cvtepu16_epi32(_mm256_castsi256_si128(c)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(counts + 8),
+			_mm256_cvtepu16_epi32(_mm256_extracti128_si256(c, 1)));
+#endif
+#endif
+}
+#endif // TINYGRAPH_AVX2
+
+// sum of |rows[u]| over u < n
+inline int popcount(const Set* rows, int n) {
+#ifdef TINYGRAPH_AVX2
+    __m256i sums = _mm256_setzero_si256();
+    for (int b = 0; b < numBlocks(n); ++b)
+	sums = accumulate(sums, popcountBytes(load(rows, b)));
+    return total(sums);
+#else
+    int s = 0;
+    for (int u = 0; u < n; ++u)
+	s += rows[u].size();
+    return s;
+#endif
+}
+
+// sum of |rows[u] & mask| over u in mask, for mask within [0, n)
+inline int popcountMasked(const Set* rows, int n, Set mask) {
+#ifdef TINYGRAPH_AVX2
+    __m256i m = broadcast(mask);
+    __m256i bits = laneBits();
+    __m256i sums = _mm256_setzero_si256();
+    for (int b = 0; b < numBlocks(n); ++b) {
+	__m256i x = _mm256_and_si256(_mm256_and_si256(load(rows, b), m), selectRows(m, bits));
+	sums = accumulate(sums, popcountBytes(x));
+	bits = nextLaneBits(bits);
+    }
+    return total(sums);
+#else
+    (void) n;
+    int s = 0;
+    for (int u : mask)
+	s += (rows[u] & mask).size();
+    return s;
+#endif
+}
+
+// counts[u] = |rows[u] & mask| for u < n; counts must have room for
+// MAXN elements
+inline void popcounts(const Set* rows, int n, Set mask, int* counts) {
+#ifdef TINYGRAPH_AVX2
+    __m256i m = broadcast(mask);
+    for (int b = 0; b < numBlocks(n); ++b)
+	storePopcounts(counts + b * LANES, _mm256_and_si256(load(rows, b), m));
+#else
+    for (int u = 0; u < n; ++u)
+	counts[u] = (rows[u] & mask).size();
+#endif
+}
+
+// out[u] = [0, n) - rows[u] - u for u < n; out[u] for u >= n stays
+// empty
+inline void complement(const Set* rows, int n, Set* out) {
+#ifdef TINYGRAPH_AVX2
+    __m256i all = broadcast(Set::ofRange(n));
+    __m256i bits = laneBits();
+    for (int b = 0; b < numBlocks(n); ++b) {
+	__m256i x = _mm256_andnot_si256(_mm256_or_si256(load(rows, b), bits), all);
+	store(out, b, _mm256_and_si256(x, selectRows(all, bits)));
+	bits = nextLaneBits(bits);
+    }
+#else
+    Set all = Set::ofRange(n);
+    for (int u = 0; u < n; ++u)
+	out[u] = all - rows[u] - u;
+#endif
+}
+
+}  // namespace Rows
+
+#endif  // TINYGRAPH_ROWS_HH_INCLUDED
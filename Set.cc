@@ -17,6 +17,9 @@
 
 #include "Set.hh"
 
+#if MAXN <= WORDSIZE
+
+constexpr int Set::WORDS;
 constexpr int Set::MAX_ELEMENT;
 
 std::ostream& operator<<(std::ostream& out, Set s) {
@@ -31,3 +34,4 @@ std::ostream& operator<<(std::ostream& out, Set s) {
     return out << '}';
 }
 
+#endif  // MAXN <= WORDSIZE
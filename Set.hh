@@ -24,6 +24,14 @@
 
 #include "bits.hh"
 
+#if MAXN > WORDSIZE
+
+#include "BasicSet.hh"
+
+using Set = BasicSet<(MAXN + WORDSIZE - 1) / WORDSIZE>;
+
+#else
+
 class Set {
 public:
     Set(std::initializer_list<int> xs) : bits_(0) {
@@ -37,6 +45,7 @@ public:
 	return Set(x == 0 ? 0 : word(-1) >> (WORDSIZE - x));
     }
 
+    static constexpr int WORDS = 1;
     static constexpr int MAX_ELEMENT = WORDSIZE - 1;
 
     bool isEmpty() const { return bits_ == 0; }
@@ -87,6 +96,22 @@ public:
     bool isSubset(Set other) const { return (*this - other).isEmpty(); }
     bool isSuperset(Set other) const { return other.isSubset(*this); }
 
+    // the elements of this at the positions of mask, renumbered to
+    // 0, ..., |mask| - 1
+    Set extract(Set mask) const { return Set(extractBits(bits_, mask.bits_)); }
+    // without x, with the elements above x moved down by one
+    Set deleted(int x) const { assert(x >= 0 && x <= MAX_ELEMENT); return Set(delbit(bits_, x)); }
+    // with all elements increased by k; those beyond MAX_ELEMENT are lost
+    Set shifted(int k) const { assert(k >= 0); return k >= WORDSIZE ? Set() : Set(bits_ << k); }
+
+    // as row of m nauty setwords, which have their bits in reverse order
+    void toNauty(word* row, int m) const {
+	row[0] = reverseBits(bits_);
+	for (int i = 1; i < m; ++i)
+	    row[i] = 0;
+    }
+    static Set ofNauty(const word* row, int m) { assert(m == 1); return Set(reverseBits(row[0])); }
+
     class Iterator {
 	friend Set;
     public:
@@ -100,6 +125,31 @@ public:
     Iterator begin() const { return Iterator(bits_); }
     Iterator end() const { return Iterator(0); }
 
+    // the part of the sets from a Subsets or Combinations iterator It
+    // with ranks first, ..., last - 1, so that a loop over them can be
+    // split into chunks
+    template<typename It>
+    class Range {
+    public:
+	Range(It first, uint64_t size) : first_(first), size_(size) { }
+	class Iterator {
+	    friend Range;
+	public:
+	    bool operator!=(const Iterator&) const { return left_ != 0; }
+	    Set operator*() const { return *it_; }
+	    Iterator& operator++() { if (--left_) ++it_; return *this; }
+	private:
+	    Iterator(It it, uint64_t left) : it_(it), left_(left) { }
+	    It it_;
+	    uint64_t left_;
+	};
+	Iterator begin() const { return Iterator(first_, size_); }
+	Iterator end() const { return Iterator(first_, 0); }
+    private:
+	It first_;
+	uint64_t size_;
+    };
+
     class Subsets {
     public:
 	Subsets(word set) : set_(set) { }
@@ -111,18 +161,81 @@ public:
 	    Set operator*() const { return Set(subset_); }
 	    Iterator& operator++() { subset_ = (subset_ - set_) & set_; done_ = subset_ == 0; return *this; }
 	private:
-	    Iterator(word set, bool done) : set_(set), subset_(0), done_(done) { }
+	    Iterator(word set, bool done, word subset = 0) : set_(set), subset_(subset), done_(done) { }
 	    word set_;
 	    word subset_;
 	    bool done_;
 	};
 	Iterator begin() const { return Iterator(set_, false); }
 	Iterator end() const { return Iterator(set_, true); }
+
+	// The subsets are enumerated by counting in binary on the
+	// positions of set, so the rank is given by PEXT and PDEP.
+	uint64_t size() const { assert(popcount(set_) < 64); return uint64_t(1) << popcount(set_); }
+	uint64_t rank(Set subset) const {
+	    assert(subset.isSubset(Set(set_)));
+	    return extractBits(subset.bits_, set_);
+	}
+	Set unrank(uint64_t r) const { assert(r < size()); return Set(depositBits(word(r), set_)); }
+	Range<Iterator> range(uint64_t first, uint64_t last) const {
+	    assert(first <= last && last <= size());
+	    return Range<Iterator>(Iterator(set_, false, first < last ? unrank(first).bits_ : 0),
+				   last - first);
+	}
     private:
 	word set_;
     };
     Subsets subsets() { return Subsets(bits_); }
 
+    // a subset from GrayCodeSubsets, with the element by which it
+    // differs from the previous one, or -1 for the first (empty) one
+    class GrayCodeStep {
+	friend Set;
+    public:
+	Set subset() const { return Set(subset_); }
+	int changed() const { return changed_; }
+	bool added() const { return changed_ >= 0 && ((subset_ >> changed_) & 1); }
+    private:
+	GrayCodeStep(word subset, int changed) : subset_(subset), changed_(changed) { }
+	word subset_;
+	int changed_;
+    };
+
+    // all subsets, each differing from the previous one in a single
+    // element, so that loops over them can keep values up to date
+    // instead of computing them from scratch
+    class GrayCodeSubsets {
+    public:
+	GrayCodeSubsets(word set) : set_(set) { }
+	class Iterator {
+	    friend Set;
+	public:
+	    bool operator!=(Iterator) const { return !done_; }
+	    GrayCodeStep operator*() const { return GrayCodeStep(subset_, changed_); }
+	    Iterator& operator++() {
+		// step i toggles the element at position ctz(i) of set
+		++i_;
+		word bit = depositBits(i_ & -i_, set_);
+		subset_ ^= bit;
+		changed_ = bit ? ctz(bit) : -1;
+		done_ = bit == 0;
+		return *this;
+	    }
+	private:
+	    Iterator(word set, bool done) : set_(set), i_(0), subset_(0), changed_(-1), done_(done) { }
+	    word set_;
+	    word i_;
+	    word subset_;
+	    int changed_;
+	    bool done_;
+	};
+	Iterator begin() const { return Iterator(set_, false); }
+	Iterator end() const { return Iterator(set_, true); }
+    private:
+	word set_;
+    };
+    GrayCodeSubsets grayCodeSubsets() { return GrayCodeSubsets(bits_); }
+
     class Combinations {
     public:
 	Combinations(word set, int k) : set_(set), k_(k) { }
@@ -174,6 +287,37 @@ public:
 		return ++it;
 	    }
 	}
+
+	// The combinations are enumerated in colexicographic order, so
+	// the one at positions p_1 < ... < p_k of set has rank
+	// sum_i binomial(p_i, i).
+	uint64_t size() const { return binomial(popcount(set_), k_); }
+	uint64_t rank(Set comb) const {
+	    assert(comb.isSubset(Set(set_)) && comb.size() == k_);
+	    uint64_t r = 0;
+	    int i = 0;
+	    for (int p : Set(extractBits(comb.bits_, set_)))
+		r += binomial(p, ++i);
+	    return r;
+	}
+	Set unrank(uint64_t r) const {
+	    assert(r < size());
+	    word positions = 0;
+	    int p = popcount(set_);
+	    for (int i = k_; i >= 1; --i) {
+		do
+		    --p;
+		while (binomial(p, i) > r);
+		r -= binomial(p, i);
+		positions |= word(1) << p;
+	    }
+	    return Set(depositBits(positions, set_));
+	}
+	Range<Iterator> range(uint64_t first, uint64_t last) const {
+	    assert(first <= last && last <= size());
+	    return Range<Iterator>(Iterator(set_, first < last ? unrank(first).bits_ : 0),
+				   last - first);
+	}
     private:
 	word set_;
 	int k_;
@@ -187,4 +331,6 @@ private:
 
 std::ostream& operator<<(std::ostream& out, Set s);
 
+#endif  // MAXN > WORDSIZE
+
 #endif  // TINYGRAPH_SET_HH_INCLUDED
@@ -17,6 +17,8 @@
 
 #include "Subgraph.hh"
 
+#include <unordered_map>
+
 namespace Subgraph {
 
 // simple and unoptimized subgraph isomorphism
@@ -116,11 +118,142 @@ bool has(const Graph& g, const Graph& f) {
     return extendHas(g, f, g.vertices(), assignment);
 }
 
-std::function<bool(const Graph&)> hasTest(Graph f) {
+// f with vertex i moved to position 0, for each i whose result differs
+static std::vector<Graph> rootedAtEachVertex(const Graph& f) {
+    std::vector<Graph> rooted;
+    for (int i = 0; i < f.n(); ++i) {
+	std::vector<int> order = {i};
+	for (int v = 0; v < f.n(); ++v)
+	    if (v != i)
+		order.push_back(v);
+	Graph r(f.n());
+	for (int u = 0; u < f.n(); ++u)
+	    for (int v = u + 1; v < f.n(); ++v)
+		if (f.hasEdge(order[u], order[v]))
+		    r.addEdge(u, v);
+	if (std::find(rooted.begin(), rooted.end(), r) == rooted.end())
+	    rooted.push_back(r);
+    }
+    return rooted;
+}
+
+bool hasInducedWithVertex(const Graph& g, const Graph& f, int u) {
+    // every graph contains the empty graph
+    if (f.n() == 0)
+	return true;
+    if (g.n() < f.n())
+	return false;
+    for (const Graph& r : rootedAtEachVertex(f)) {
+	std::vector<int> assignment = {u};
+	if (extendHasInduced(g, r, g.vertices() - u, assignment))
+	    return true;
+    }
+    return false;
+}
+
+// Specialized implementations for patterns, keyed by the graph6 of
+// their canonical form, so that finding one takes one canonical
+// labeling and a hash lookup
+template<typename F>
+class Registry {
+public:
+    Registry(std::initializer_list<std::pair<const char*, F>> entries) {
+	for (const auto& e : entries)
+	    add(Graph::byName(e.first), e.second);
+    }
+    void add(const Graph& f, F function) { functions_[f.canonical().graph6()] = function; }
+    // fCanon must be canonical
+    F find(const Graph& fCanon) const {
+	auto it = functions_.find(fCanon.graph6());
+	return it == functions_.end() ? nullptr : it->second;
+    }
+private:
+    std::unordered_map<std::string, F> functions_;
+};
+
+static Registry<HasTest>& hasTests() {
+    static Registry<HasTest> registry = {
+	{"K3", hasK3},
+	{"C4", hasC4},
+	{"K4", hasK4},
+    };
+    return registry;
+}
+
+static Registry<HasWithVertexTest>& hasWithVertexTests() {
+    static Registry<HasWithVertexTest> registry = {
+	{"K3", hasK3WithVertex},
+	{"C4", hasC4WithVertex},
+	{"K4", hasK4WithVertex},
+    };
+    return registry;
+}
+
+static Registry<HasWithVertexTest>& hasInducedWithVertexTests() {
+    static Registry<HasWithVertexTest> registry = {
+	{"P3",   hasInducedP3WithVertex},
+	{"K3",   hasK3WithVertex},
+	{"claw", hasInducedClawWithVertex},
+	{"C4",   hasInducedC4WithVertex},
+	{"K4",   hasK4WithVertex},
+    };
+    return registry;
+}
+
+static Registry<HasTest>& hasInducedTests() {
+    static Registry<HasTest> registry = {
+	{"P3",      hasInducedP3},
+	{"K3",      hasK3},
+	{"claw",    hasInducedClaw},
+	{"paw",     hasInducedPaw},
+	{"C4",      hasInducedC4},
+	{"diamond", hasInducedDiamond},
+	{"K4",      hasK4},
+	{"P5",      hasInducedP5},
+	{"C5",      hasInducedC5},
+	{"fork",    hasInducedFork},
+	{"house",   hasInducedHouse},
+	{"bull",    hasInducedBull},
+    };
+    return registry;
+}
+
+static Registry<CountFunction>& countInducedFunctions() {
+    static Registry<CountFunction> registry = {
+	{"P3",   countInducedP3s},
+	{"P4",   countInducedP4s},
+	{"P5",   countInducedP5s},
+	{"claw", countInducedClaws},
+	{"paw",  countInducedPaws},
+	{"C4",   countInducedC4s},
+    };
+    return registry;
+}
+
+void registerHasTest(const Graph& f, HasTest test) {
+    hasTests().add(f, test);
+}
+
+void registerHasWithVertexTest(const Graph& f, HasWithVertexTest test) {
+    hasWithVertexTests().add(f, test);
+}
+
+void registerHasInducedTest(const Graph& f, HasTest test) {
+    hasInducedTests().add(f, test);
+}
+
+void registerHasInducedWithVertexTest(const Graph& f, HasWithVertexTest test) {
+    hasInducedWithVertexTests().add(f, test);
+}
+
+void registerCountInducedFunction(const Graph& f, CountFunction count) {
+    countInducedFunctions().add(f, count);
+}
+
+HasTest hasTest(Graph f) {
     f = f.canonical();
-    if (f == Graph::byName("K3")     .canonical()) return hasK3;
-    if (f == Graph::byName("C4")     .canonical()) return hasC4;
-    if (f == Graph::byName("K4")     .canonical()) return hasK4;
+    if (HasTest test = hasTests().find(f))
+	return test;
     return [f](const Graph& g) {
 	if (g.n() < f.n())
 	    return false;
@@ -129,20 +262,53 @@ std::function<bool(const Graph&)> hasTest(Graph f) {
     };
 }
 
-std::function<bool(const Graph&)> hasInducedTest(Graph f) {
+HasWithVertexTest hasWithVertexTest(Graph f) {
     f = f.canonical();
-    if (f == Graph::byName("P3")     .canonical()) return hasInducedP3;
-    if (f == Graph::byName("K3")     .canonical()) return hasK3;
-    if (f == Graph::byName("claw")   .canonical()) return hasInducedClaw;
-    if (f == Graph::byName("paw")    .canonical()) return hasInducedPaw;
-    if (f == Graph::byName("C4")     .canonical()) return hasInducedC4;
-    if (f == Graph::byName("diamond").canonical()) return hasInducedDiamond;
-    if (f == Graph::byName("K4")     .canonical()) return hasK4;
-    if (f == Graph::byName("P5")     .canonical()) return hasInducedP5;
-    if (f == Graph::byName("C5")     .canonical()) return hasInducedC5;
-    if (f == Graph::byName("fork")   .canonical()) return hasInducedFork;
-    if (f == Graph::byName("house")  .canonical()) return hasInducedHouse;
-    if (f == Graph::byName("bull")   .canonical()) return hasInducedBull;
+    if (HasWithVertexTest test = hasWithVertexTests().find(f))
+	return test;
+    // every graph contains the empty graph, and there is no vertex
+    // to root it at
+    if (f.n() == 0)
+	return [](const Graph&, int) { return true; };
+    std::vector<Graph> rooted = rootedAtEachVertex(f);
+    int n = f.n();
+    return [rooted, n](const Graph& g, int u) {
+	if (g.n() < n)
+	    return false;
+	for (const Graph& r : rooted) {
+	    std::vector<int> assignment = {u};
+	    if (extendHas(g, r, g.vertices() - u, assignment))
+		return true;
+	}
+	return false;
+    };
+}
+
+HasWithVertexTest hasInducedWithVertexTest(Graph f) {
+    f = f.canonical();
+    if (HasWithVertexTest test = hasInducedWithVertexTests().find(f))
+	return test;
+    // as in hasWithVertexTest
+    if (f.n() == 0)
+	return [](const Graph&, int) { return true; };
+    std::vector<Graph> rooted = rootedAtEachVertex(f);
+    int n = f.n();
+    return [rooted, n](const Graph& g, int u) {
+	if (g.n() < n)
+	    return false;
+	for (const Graph& r : rooted) {
+	    std::vector<int> assignment = {u};
+	    if (extendHasInduced(g, r, g.vertices() - u, assignment))
+		return true;
+	}
+	return false;
+    };
+}
+
+HasTest hasInducedTest(Graph f) {
+    f = f.canonical();
+    if (HasTest test = hasInducedTests().find(f))
+	return test;
     return [f](const Graph& g) {
 	if (g.n() < f.n())
 	    return false;
@@ -165,6 +331,14 @@ bool hasInducedP3(const Graph& g) {
     return false;
 }
 
+bool hasInducedP3WithVertex(const Graph& g, int u) {
+    Set s = g.neighbors(u) + u;
+    for (int v : g.neighbors(u))
+	if (g.neighbors(v) + v != s)
+	    return true;
+    return false;
+}
+
 bool hasK3(const Graph& g) {
     for (int u = 0; u < g.n(); ++u)
 	for (int v : g.neighbors(u).above(u))
@@ -173,6 +347,13 @@ bool hasK3(const Graph& g) {
     return false;
 }
 
+bool hasK3WithVertex(const Graph& g, int u) {
+    for (int v : g.neighbors(u))
+	if ((g.neighbors(u) & g.neighbors(v)).nonempty())
+	    return true;
+    return false;
+}
+
 bool hasK4(const Graph& g) {
     for (int u = 0; u < g.n() - 3; ++u)
 	for (int v : g.neighbors(u).above(u))
@@ -182,6 +363,14 @@ bool hasK4(const Graph& g) {
     return false;
 }
 
+bool hasK4WithVertex(const Graph& g, int u) {
+    for (int v : g.neighbors(u))
+	for (int w : g.neighbors(v).above(v) & g.neighbors(u))
+	    if ((g.neighbors(w) & g.neighbors(u) & g.neighbors(v)).nonempty())
+		return true;
+    return false;
+}
+
 bool hasInducedClaw(const Graph& g) {
     for (int u = 0; u < g.n(); ++u)
 	for (int v : g.nonneighbors(u).above(u))
@@ -191,11 +380,19 @@ bool hasInducedClaw(const Graph& g) {
     return false;
 }
 
-bool hasInducedClaw(const Graph& g, int u) {
+bool hasInducedClawWithVertex(const Graph& g, int u) {
+    // u as center
     for (int v : g.neighbors(u))
 	for (int w : (g.neighbors(u) - g.neighbors(v)).above(v))
-	    if ((g.neighbors(u) - g.neighbors(v) - g.neighbors(w)).nonempty())
+	    if ((g.neighbors(u) - g.neighbors(v) - g.neighbors(w) - v - w).nonempty())
+		return true;
+    // u as leaf of center c
+    for (int c : g.neighbors(u)) {
+	Set others = g.neighbors(c) - g.neighbors(u) - u;
+	for (int v : others)
+	    if ((others - g.neighbors(v) - v).nonempty())
 		return true;
+    }
     return false;
 }
 
@@ -208,12 +405,21 @@ bool hasInducedPaw(const Graph& g) {
     return false;
 }
 
+// two vertices with at least two common neighbors, one popcount per
+// pair
 bool hasC4(const Graph& g) {
     for (int u = 0; u < g.n(); ++u)
-	for (int v : g.neighbors(u).above(u))
-	    for (int w : g.neighbors(u).above(v))
-		if (((g.neighbors(v) & g.neighbors(w)) - u).nonempty())
-		    return true;
+	for (int v : g.vertices().above(u))
+	    if ((g.neighbors(u) & g.neighbors(v)).size() >= 2)
+		return true;
+    return false;
+}
+
+bool hasC4WithVertex(const Graph& g, int u) {
+    for (int v : g.neighbors(u))
+	for (int w : g.neighbors(u).above(v))
+	    if (((g.neighbors(v) & g.neighbors(w)) - u).nonempty())
+		return true;
     return false;
 }
 
@@ -226,6 +432,14 @@ bool hasInducedC4(const Graph& g) {
     return false;
 }
 
+bool hasInducedC4WithVertex(const Graph& g, int u) {
+    for (int v : g.neighbors(u))
+	for (int w : (g.neighbors(u) - g.neighbors(v)).above(v))
+	    if (((g.neighbors(v) & g.neighbors(w)) - g.neighbors(u) - u).nonempty())
+		return true;
+    return false;
+}
+
 bool hasInducedDiamond(const Graph& g) {
     for (int u = 0; u < g.n(); ++u)
 	for (int v : g.neighbors(u))
@@ -294,14 +508,10 @@ bool hasInducedBull(const Graph& g) {
     return false;
 }
 
-std::function<uint64_t(const Graph&)> countInducedFunction(Graph f) {
+CountFunction countInducedFunction(Graph f) {
     f = f.canonical();
-    if (f == Graph::byName("P3")  .canonical()) return countInducedP3s;
-    if (f == Graph::byName("P4")  .canonical()) return countInducedP4s;
-    if (f == Graph::byName("P5")  .canonical()) return countInducedP5s;
-    if (f == Graph::byName("claw").canonical()) return countInducedClaws;
-    if (f == Graph::byName("paw") .canonical()) return countInducedPaws;
-    if (f == Graph::byName("C4")  .canonical()) return countInducedC4s;
+    if (CountFunction count = countInducedFunctions().find(f))
+	return count;
     return [f](const Graph& g) {
         return countInduced(g, f);
     };
@@ -22,7 +22,21 @@
 
 namespace Subgraph {
 
-std::function<uint64_t(const Graph&)> countInducedFunction(Graph f);
+typedef std::function<bool(const Graph&)> HasTest;
+typedef std::function<bool(const Graph&, int)> HasWithVertexTest;
+typedef std::function<uint64_t(const Graph&)> CountFunction;
+
+// The functions returning tests look up specialized implementations
+// for f by its canonical form, and otherwise fall back to a generic
+// search. The register functions add or replace the implementation
+// for f (in any labeling); they are not thread-safe.
+void registerHasTest(const Graph& f, HasTest test);
+void registerHasWithVertexTest(const Graph& f, HasWithVertexTest test);
+void registerHasInducedTest(const Graph& f, HasTest test);
+void registerHasInducedWithVertexTest(const Graph& f, HasWithVertexTest test);
+void registerCountInducedFunction(const Graph& f, CountFunction count);
+
+CountFunction countInducedFunction(Graph f);
 uint64_t countInduced(const Graph &g, const Graph& f);
 uint64_t countInducedP3s(const Graph& g);
 uint64_t countInducedP4s(const Graph& g);
@@ -32,8 +46,8 @@ uint64_t countInducedPaws(const Graph& g);
 uint64_t countInducedC4s(const Graph& g);
 uint64_t countInducedCycles(const Graph& g);
 
-std::function<bool(const Graph&)> hasTest(Graph f);
-std::function<bool(const Graph&)> hasInducedTest(Graph f);
+HasTest hasTest(Graph f);
+HasTest hasInducedTest(Graph f);
 bool hasInduced(const Graph &g, const Graph& f);
 bool hasInducedP3(const Graph &g);
 bool hasK3(const Graph &g);
@@ -51,6 +65,18 @@ bool hasInducedBull(const Graph &g);
 bool hasLongHole(const Graph& g);
 bool hasOddHole(const Graph& g);
 
+// Only look for copies of f that contain vertex u. When u was just
+// added to a graph without f, this is equivalent to the full test.
+HasWithVertexTest hasWithVertexTest(Graph f);
+HasWithVertexTest hasInducedWithVertexTest(Graph f);
+bool hasInducedWithVertex(const Graph &g, const Graph& f, int u);
+bool hasInducedP3WithVertex(const Graph &g, int u);
+bool hasK3WithVertex(const Graph &g, int u);
+bool hasK4WithVertex(const Graph &g, int u);
+bool hasInducedClawWithVertex(const Graph &g, int u);
+bool hasC4WithVertex(const Graph &g, int u);
+bool hasInducedC4WithVertex(const Graph &g, int u);
+
 }  // namespace Subgraph
 
 #endif  // TINYGRAPH_SUBGRAPH_HH_INCLUDED
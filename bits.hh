@@ -18,6 +18,8 @@
 #ifndef TINYGRAPH_BITS_HH_INCLUDED
 #define TINYGRAPH_BITS_HH_INCLUDED
 
+#include <cassert>
+#include <climits>
 #include <cstdint>
 
 #include "wordsize.h"
@@ -62,7 +64,7 @@ inline int clz(word x) {
 		  sizeof (word) == sizeof (long long),
 		  "cannot determine clz intrinsic");
     if (sizeof (word) <= sizeof (int))
-	return __builtin_clz(x);
+	return __builtin_clz(x) - (sizeof (int) - sizeof (word)) * CHAR_BIT;
     else if (sizeof (word) == sizeof (long))
 	return __builtin_clzl(x);
     else
@@ -109,8 +111,25 @@ inline word highestBits(word x, int k) {
     return x;
 }
 
-inline word extractBits(word x, word mask) {
-    // available as PEXT in BMI2 (Bit Manipulation Instruction Set 2, Haswell)
+// n choose k, for 0 <= n <= 64; all of them fit into 64 bits
+inline uint64_t binomial(int n, int k) {
+    assert(n >= 0 && n <= 64);
+    struct Table {
+	Table() {
+	    for (int i = 0; i <= 64; ++i) {
+		c[i][0] = 1;
+		for (int j = 1; j <= i; ++j)
+		    c[i][j] = c[i - 1][j - 1] + c[i - 1][j];
+	    }
+	}
+	uint64_t c[65][65] = {};
+    };
+    static const Table table;
+    return k < 0 || k > n ? 0 : table.c[n][k];
+}
+
+// the bits of x at the positions in mask, packed into the low bits
+inline word extractBitsPortable(word x, word mask) {
     word r = 0;
     for (word b = 1; mask; b <<= 1) {
         if (x & (mask & -mask))
@@ -120,4 +139,73 @@ inline word extractBits(word x, word mask) {
     return r;
 }
 
+// the low bits of x, spread out to the positions in mask
+inline word depositBitsPortable(word x, word mask) {
+    word r = 0;
+    for (word b = 1; mask; b <<= 1) {
+	if (x & b)
+	    r |= mask & -mask;
+	mask &= mask - 1;
+    }
+    return r;
+}
+
+// PEXT and PDEP from BMI2 (Haswell; microcoded and slow on AMD before
+// Zen 3, so avoid -march=native builds there)
+#if defined(__BMI2__)
+#define TINYGRAPH_BMI2 inline
+#elif defined(__x86_64__) && defined(__GNUC__)
+#define TINYGRAPH_BMI2 __attribute__((target("bmi2"))) inline
+#define TINYGRAPH_BMI2_DISPATCH
+#endif
+
+#ifdef TINYGRAPH_BMI2
+#include <immintrin.h>
+#endif
+
+#ifdef TINYGRAPH_BMI2
+TINYGRAPH_BMI2 word extractBitsBmi2(word x, word mask) {
+#if WORDSIZE == 64
+    return _pext_u64(x, mask);
+#else
+    return _pext_u32(x, mask);
+#endif
+}
+
+TINYGRAPH_BMI2 word depositBitsBmi2(word x, word mask) {
+#if WORDSIZE == 64
+    return _pdep_u64(x, mask);
+#else
+    return _pdep_u32(x, mask);
+#endif
+}
+#endif
+
+#ifdef TINYGRAPH_BMI2_DISPATCH
+inline bool cpuHasBmi2() {
+    static const bool hasBmi2 = (__builtin_cpu_init(), __builtin_cpu_supports("bmi2"));
+    return hasBmi2;
+}
+#endif
+
+inline word extractBits(word x, word mask) {
+#if defined(TINYGRAPH_BMI2_DISPATCH)
+    return cpuHasBmi2() ? extractBitsBmi2(x, mask) : extractBitsPortable(x, mask);
+#elif defined(TINYGRAPH_BMI2)
+    return extractBitsBmi2(x, mask);
+#else
+    return extractBitsPortable(x, mask);
+#endif
+}
+
+inline word depositBits(word x, word mask) {
+#if defined(TINYGRAPH_BMI2_DISPATCH)
+    return cpuHasBmi2() ? depositBitsBmi2(x, mask) : depositBitsPortable(x, mask);
+#elif defined(TINYGRAPH_BMI2)
+    return depositBitsBmi2(x, mask);
+#else
+    return depositBitsPortable(x, mask);
+#endif
+}
+
 #endif // TINYGRAPH_BITS_HH_INCLUDED
@@ -15,14 +15,15 @@
    with this program; if not, write to the Free Software Foundation, Inc.,
    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.	*/
 
-#include <ctime>
 #include <map>
 #include <set>
 #include <iostream>
+#include <sstream>
 
 #include "Classes.hh"
 #include "Invariants.hh"
 #include "EulerTransform.hh"
+#include "Parallel.hh"
 
 using PropertyTest = std::function<bool(const Graph&)>;
 
@@ -75,11 +76,14 @@ void output(const std::vector<std::vector<T>>& counts) {
     std::cout << std::endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    int jobs = 1;
+    if (argc == 3 && std::string(argv[1]) == "-j")
+	jobs = std::stoi(argv[2]);
     std::vector<std::vector<uint64_t>> counts;
     std::vector<double> times;
     for (int n = n0; ; ++n) {
-	auto tStart = double(std::clock()) / CLOCKS_PER_SEC;
+	auto tStart = Parallel::cpuTime();
 	std::cerr << "\n\n--- n = " << n;
 	if (times.size() >= 2) {
 	    auto tn = times.back();
@@ -92,14 +96,32 @@ int main() {
 	    std::cerr << std::endl;
 	}
 	counts.resize(n + 1);
-	auto counter = [&counts, n](const Graph& g) {
-			   const auto k = invariant(g);
-			   if (k >= int(counts[n].size()))
-			       counts[n].resize(k + 1);
-			   ++counts[n][k];
-		       };
-	Graph::enumerate(n, counter, connectedOnly ? Graph::CONNECTED : 0);
-	auto tEnd = double(std::clock()) / CLOCKS_PER_SEC;
+	auto countPart = [n](int res, int mod) {
+	    std::vector<uint64_t> partCounts;
+	    auto counter = [&partCounts](const Graph& g) {
+			       const auto k = invariant(g);
+			       if (k >= int(partCounts.size()))
+				   partCounts.resize(k + 1);
+			       ++partCounts[k];
+			   };
+	    Graph::enumeratePart(n, res, mod, counter, nullptr, connectedOnly ? Graph::CONNECTED : 0);
+	    std::ostringstream out;
+	    for (auto c : partCounts)
+		out << c << ' ';
+	    return out.str();
+	};
+	auto merge = [&counts, n](int, const std::string& partCounts) {
+	    std::istringstream in(partCounts);
+	    uint64_t c;
+	    for (size_t k = 0; in >> c; ++k) {
+		if (k >= counts[n].size())
+		    counts[n].resize(k + 1);
+		counts[n][k] += c;
+	    }
+	};
+	int parts = jobs > 1 && n >= 8 ? 16 * jobs : 1;
+	Parallel::forEachPart(parts, jobs, countPart, merge);
+	auto tEnd = Parallel::cpuTime();
 	auto t = tEnd - tStart;
 	times.push_back(t);
 	std::cerr << "time: " << t << 's' << std::endl;
@@ -17,103 +17,180 @@
 
 // Count the number of graphs on n nodes with a certain property.
 
+#include "Checkpoint.hh"
 #include "Classes.hh"
+#include "Counter.hh"
 #include "EulerTransform.hh"
 #include "Graph.hh"
 #include "Invariants.hh"
+#include "Parallel.hh"
 #include "Subgraph.hh"
 
-#include <ctime>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <map>
+#include <memory>
+#include <set>
 #include <functional>
+#include <sstream>
+
+#include <unistd.h>
 
 auto maxCpuTime = 1e6;
 
 using PropertyTest = std::function<bool(const Graph&)>;
+// test only the parts of G that involve vertex u, assuming G - u has
+// the property
+using PropertyVertexTest = std::function<bool(const Graph&, int)>;
 
 struct Property {
-    Property(PropertyTest t, bool h, bool d)
-	: test(t), hereditary(h), determinedByConnectedComponents(d) { }
+    Property(PropertyTest t, bool h, bool d, bool b, PropertyVertexTest vt = nullptr)
+	: test(t), vertexTest(vt), hereditary(h), determinedByConnectedComponents(d),
+	  determinedByBlocks(b) { }
     PropertyTest test;
+    PropertyVertexTest vertexTest;
     // if G has the property, then also every induced subgraph of G has
     bool hereditary;
     // G has the property if and only if each connected subgraph has the property
     bool determinedByConnectedComponents;
+    // G has the property if and only if each block (biconnected
+    // component or bridge) has the property
+    bool determinedByBlocks;
 };
 
 struct GengProperty {
-    GengProperty(int f, bool h, bool d)
-	: flag(f), hereditary(h), determinedByConnectedComponents(d) { }
+    GengProperty(int f, PropertyTest t, bool h, bool d, bool b)
+	: flag(f), test(t), hereditary(h), determinedByConnectedComponents(d), determinedByBlocks(b) { }
     int flag;
+    // for when geng cannot filter, since other queries need the graphs
+    PropertyTest test;
     bool hereditary;
     bool determinedByConnectedComponents;
+    bool determinedByBlocks;
 };
 
 std::map<std::string, Property> properties = {
-    {"3-colorable",   {[](const Graph& g) { return Invariants::kColorable(g, 3); }, true,  true}},
-    {"4-colorable",   {[](const Graph& g) { return Invariants::kColorable(g, 4); }, true,  true}},
-    {"5-colorable",   {[](const Graph& g) { return Invariants::kColorable(g, 5); }, true,  true}},
-    {"6-colorable",   {[](const Graph& g) { return Invariants::kColorable(g, 6); }, true,  true}},
-    {"7-colorable",   {[](const Graph& g) { return Invariants::kColorable(g, 7); }, true,  true}},
-    {"8-colorable",   {[](const Graph& g) { return Invariants::kColorable(g, 8); }, true,  true}},
-    {"9-colorable",   {[](const Graph& g) { return Invariants::kColorable(g, 9); }, true,  true}},
-    {"radius-2",      {[](const Graph& g) { return Invariants::radius(g) == 2; }, false, false}},
-    {"diameter-2",    {[](const Graph& g) { return Invariants::diameter(g) == 2; }, false, false}},
-    {"diameter-3",    {[](const Graph& g) { return Invariants::diameter(g) == 3; }, false, false}},
-    {"diameter-4",    {[](const Graph& g) { return Invariants::diameter(g) == 4; }, false, false}},
-    {"diameter-5",    {[](const Graph& g) { return Invariants::diameter(g) == 5; }, false, false}},
-    {"diameter-6",    {[](const Graph& g) { return Invariants::diameter(g) == 6; }, false, false}},
-    {"diameter-7",    {[](const Graph& g) { return Invariants::diameter(g) == 7; }, false, false}},
-    {"diameter-8",    {[](const Graph& g) { return Invariants::diameter(g) == 8; }, false, false}},
-    {"diameter-9",    {[](const Graph& g) { return Invariants::diameter(g) == 9; }, false, false}},
-    {"diameter<=2",   {[](const Graph& g) { return Invariants::diameter(g) <= 2; }, false, false}},
-    {"diameter<=3",   {[](const Graph& g) { return Invariants::diameter(g) <= 3; }, false, false}},
-    {"diameter<=4",   {[](const Graph& g) { return Invariants::diameter(g) <= 4; }, false, false}},
-    {"diameter<=5",   {[](const Graph& g) { return Invariants::diameter(g) <= 5; }, false, false}},
-    {"diameter<=6",   {[](const Graph& g) { return Invariants::diameter(g) <= 6; }, false, false}},
-    {"diameter<=7",   {[](const Graph& g) { return Invariants::diameter(g) <= 7; }, false, false}},
-    {"diameter<=8",   {[](const Graph& g) { return Invariants::diameter(g) <= 8; }, false, false}},
-    {"diameter<=9",   {[](const Graph& g) { return Invariants::diameter(g) <= 9; }, false, false}},
-    {"P4-sparse",     {Classes::isP4Sparse,                                         true,  true}},
-    {"bipartite",     {Classes::isBipartite,                                        true,  true}},
-    {"chordal",       {Classes::isChordal,                                          true,  true}},
-    {"cochordal",{[](const Graph& g) { return Classes::isChordal(g.complement()); },true,  true}},
-    {"eulerian",      {Classes::isEulerian,                                         false, true}},
-    {"hamiltonian",   {Classes::isHamiltonian,                                      false, false}},
-    {"long-hole-free",{[](const Graph& g) { return !Subgraph::hasLongHole(g); },    true,  true}},
-    {"monopolar",     {Classes::isMonopolar,                                        true,  true}},
-    {"odd-hole-free", {[](const Graph& g) { return !Subgraph::hasOddHole(g); },     true,  true}},
-    {"perfect",       {Classes::isPerfect,                                          true,  true}},
-    {"well-covered",  {Classes::isWellCovered,                                      false, true}},
-    {"prime",         {Classes::isPrime,                                            false, false}},
-    {"split",         {Classes::isSplit,                                            true,  false}},
-    {"split-cluster", {Classes::isSplitClusterGraph,                                true,  false}},
-    {"threshold",     {Classes::isThreshold,                                        true,  false}},
-    {"trivially-perfect", {Classes::isTriviallyPerfect,                             true,  true}},
-    {"weakly-chordal",{Classes::isWeaklyChordal,                                    true,  true}},
-    {"weakly-perfect",{Classes::isWeaklyPerfect,                                    false, false}},
-    {"distance-hereditary", {Classes::isDistanceHereditary,                         true,  true}},
-    {"AT-free",       {Classes::isATFree,                                           true,  true}},
-    {"elementary",    {Classes::isElementary,                                       true,  true}},
-    {"Hoang",         {Classes::isHoang,                                            true,  true}},
-    {"two-split",     {Classes::isTwoSplit,                                         true,  false}},
-    {"planar",        {Classes::isPlanar,                                           true,  true}},
-    {"cograph",       {Classes::isCograph,                                          true,  true}},
-    {"asymmetric",    {Classes::isAsymmetric,                                       false, false}},
-    {"simplicial-free", {Classes::isSimplicialFree,                                 false, true}},
-    {"two-edge-connected",              {Classes::isTwoEdgeConnected,               false, false}},
-    {"minimally-two-edge-connected",    {Classes::isMinimallyTwoEdgeConnected,      false, false}},
-    {"minimally-two-vertex-connected",  {Classes::isMinimallyTwoVertexConnected,    false, false}},
+    {"3-colorable",   {[](const Graph& g) { return Invariants::kColorable(g, 3); }, true,  true,  true}},
+    {"4-colorable",   {[](const Graph& g) { return Invariants::kColorable(g, 4); }, true,  true,  true}},
+    {"5-colorable",   {[](const Graph& g) { return Invariants::kColorable(g, 5); }, true,  true,  true}},
+    {"6-colorable",   {[](const Graph& g) { return Invariants::kColorable(g, 6); }, true,  true,  true}},
+    {"7-colorable",   {[](const Graph& g) { return Invariants::kColorable(g, 7); }, true,  true,  true}},
+    {"8-colorable",   {[](const Graph& g) { return Invariants::kColorable(g, 8); }, true,  true,  true}},
+    {"9-colorable",   {[](const Graph& g) { return Invariants::kColorable(g, 9); }, true,  true,  true}},
+    {"radius-2",      {[](const Graph& g) { return Invariants::radius(g) == 2; }, false, false, false}},
+    {"diameter-2",    {[](const Graph& g) { return Invariants::diameter(g) == 2; }, false, false, false}},
+    {"diameter-3",    {[](const Graph& g) { return Invariants::diameter(g) == 3; }, false, false, false}},
+    {"diameter-4",    {[](const Graph& g) { return Invariants::diameter(g) == 4; }, false, false, false}},
+    {"diameter-5",    {[](const Graph& g) { return Invariants::diameter(g) == 5; }, false, false, false}},
+    {"diameter-6",    {[](const Graph& g) { return Invariants::diameter(g) == 6; }, false, false, false}},
+    {"diameter-7",    {[](const Graph& g) { return Invariants::diameter(g) == 7; }, false, false, false}},
+    {"diameter-8",    {[](const Graph& g) { return Invariants::diameter(g) == 8; }, false, false, false}},
+    {"diameter-9",    {[](const Graph& g) { return Invariants::diameter(g) == 9; }, false, false, false}},
+    {"diameter<=2",   {[](const Graph& g) { return Invariants::diameter(g) <= 2; }, false, false, false}},
+    {"diameter<=3",   {[](const Graph& g) { return Invariants::diameter(g) <= 3; }, false, false, false}},
+    {"diameter<=4",   {[](const Graph& g) { return Invariants::diameter(g) <= 4; }, false, false, false}},
+    {"diameter<=5",   {[](const Graph& g) { return Invariants::diameter(g) <= 5; }, false, false, false}},
+    {"diameter<=6",   {[](const Graph& g) { return Invariants::diameter(g) <= 6; }, false, false, false}},
+    {"diameter<=7",   {[](const Graph& g) { return Invariants::diameter(g) <= 7; }, false, false, false}},
+    {"diameter<=8",   {[](const Graph& g) { return Invariants::diameter(g) <= 8; }, false, false, false}},
+    {"diameter<=9",   {[](const Graph& g) { return Invariants::diameter(g) <= 9; }, false, false, false}},
+    {"P4-sparse",     {Classes::isP4Sparse,                                         true,  true,  false}},
+    {"bipartite",     {Classes::isBipartite,                                        true,  true,  true}},
+    {"cochordal",{[](const Graph& g) { return Classes::isChordal(g.complement()); },true,  true,  false}},
+    {"eulerian",      {Classes::isEulerian,                                         false, true,  false}},
+    {"hamiltonian",   {Classes::isHamiltonian,                                      false, false, false}},
+    {"long-hole-free",{[](const Graph& g) { return !Subgraph::hasLongHole(g); },    true,  true,  true}},
+    {"monopolar",     {Classes::isMonopolar,                                        true,  true,  false}},
+    {"odd-hole-free", {[](const Graph& g) { return !Subgraph::hasOddHole(g); },     true,  true,  true}},
+    {"well-covered",  {Classes::isWellCovered,                                      false, true,  false}},
+    {"prime",         {Classes::isPrime,                                            false, false, false}},
+    {"split-cluster", {Classes::isSplitClusterGraph,                                true,  false, false}},
+    {"threshold",     {Classes::isThreshold,                                        true,  false, false}},
+    {"trivially-perfect", {Classes::isTriviallyPerfect,                             true,  true,  false}},
+    {"weakly-chordal",{Classes::isWeaklyChordal,                                    true,  true,  true}},
+    {"weakly-perfect",{Classes::isWeaklyPerfect,                                    false, false, false}},
+    {"distance-hereditary", {Classes::isDistanceHereditary,                         true,  true,  true}},
+    {"AT-free",       {Classes::isATFree,                                           true,  true,  false}},
+    {"elementary",    {Classes::isElementary,                                       true,  true,  false}},
+    {"Hoang",         {Classes::isHoang,                                            true,  true,  false}},
+    {"two-split",     {Classes::isTwoSplit,                                         true,  false, false}},
+    {"planar",        {Classes::isPlanar,                                           true,  true,  true}},
+    {"cograph",       {Classes::isCograph,                                          true,  true,  false}},
+    {"asymmetric",    {Classes::isAsymmetric,                                       false, false, false}},
+    {"simplicial-free", {Classes::isSimplicialFree,                                 false, true,  false}},
+    {"two-edge-connected",              {Classes::isTwoEdgeConnected,               false, false, false}},
+    {"minimally-two-edge-connected",    {Classes::isMinimallyTwoEdgeConnected,      false, false, false}},
+    {"minimally-two-vertex-connected",  {Classes::isMinimallyTwoVertexConnected,    false, false, false}},
 };
 
 std::map<std::string, GengProperty> gengProperties = {
-    {"biconnected",           {Graph::BICONNECTED,   false, false}},
-    {"two-vertex-connected",  {Graph::BICONNECTED,   false, false}},
-    {"triangle-free",         {Graph::TRIANGLE_FREE, true,  true}},
-    {"induced-triangle-free", {Graph::TRIANGLE_FREE, true,  true}},
-    {"square-free",           {Graph::SQUARE_FREE,   true,  true}},
-    {"C4-free",               {Graph::SQUARE_FREE,   true,  true}},
-    {"bipartite",             {Graph::BIPARTITE,     true,  true}},
+    {"biconnected",           {Graph::BICONNECTED,   Classes::isTwoVertexConnected,         false, false, false}},
+    {"two-vertex-connected",  {Graph::BICONNECTED,   Classes::isTwoVertexConnected,         false, false, false}},
+    {"triangle-free",         {Graph::TRIANGLE_FREE, [](const Graph& g) { return !Subgraph::hasK3(g); }, true,  true,  true}},
+    {"induced-triangle-free", {Graph::TRIANGLE_FREE, [](const Graph& g) { return !Subgraph::hasK3(g); }, true,  true,  true}},
+    {"square-free",           {Graph::SQUARE_FREE,   [](const Graph& g) { return !Subgraph::hasC4(g); }, true,  true,  true}},
+    {"C4-free",               {Graph::SQUARE_FREE,   [](const Graph& g) { return !Subgraph::hasC4(g); }, true,  true,  true}},
+    {"bipartite",             {Graph::BIPARTITE,     Classes::isBipartite,                  true,  true,  true}},
+    {"K4-free",               {Graph::K4_FREE,       [](const Graph& g) { return !Subgraph::hasK4(g); }, true,  true,  true}},
+    {"induced-K4-free",       {Graph::K4_FREE,       [](const Graph& g) { return !Subgraph::hasK4(g); }, true,  true,  true}},
+    {"induced-claw-free",     {Graph::CLAW_FREE,     [](const Graph& g) { return !Subgraph::hasInducedClaw(g); }, true,  true,  false}},
+    {"chordal",               {Graph::CHORDAL,       Classes::isChordal,                    true,  true,  true}},
+    {"split",                 {Graph::SPLIT,         Classes::isSplit,                      true,  false, false}},
+    {"perfect",               {Graph::PERFECT,       Classes::isPerfect,                    true,  true,  true}},
+    {"connected",             {Graph::CONNECTED,     [](const Graph& g) { return g.isConnected(); }, false, false, false}},
+    {"tree",                  {Graph::TREE,          [](const Graph& g) {
+				   return g.isConnected() && g.m() == std::max(g.n() - 1, 0); }, false, false, false}},
+};
+
+std::set<std::string> closedUnderComplement = {
+    "P4-sparse", "asymmetric", "cograph", "perfect", "prime", "split", "threshold", "weakly-chordal",
+};
+
+// A conjunction of properties. Several queries can be counted on the
+// same run of the generator.
+struct Query {
+    Query() : connectedOnly(false), determinedByConnectedComponents(true), determinedByBlocks(true),
+	      closedUnderComplement(true), gengFlags(0) { }
+    std::string name;
+    bool connectedOnly;
+    bool determinedByConnectedComponents;
+    // then only blocks are generated, and counts is obtained from
+    // blockCounts (labeled only)
+    bool determinedByBlocks;
+    // G has the property if and only if its complement has
+    bool closedUnderComplement;
+    int gengFlags;
+    std::vector<std::pair<int, GengProperty>> gengTests;
+    std::vector<PropertyTest> tests;
+    // the tests of hereditary properties, which allow pruning
+    std::vector<PropertyTest> pruneTests;
+    std::vector<PropertyVertexTest> pruneVertexTests;
+    std::vector<bignum> counts;
+    std::vector<bignum> blockCounts;
+    EulerTransform::BlockTransform countsFromBlocks;
+    // of counts, when it counts only connected graphs
+    EulerTransform::Transform countsGeneral;
+    EulerTransform::ExponentialTransform countsGeneralLabeled;
+
+    // geng only applies the flags common to all queries; check the rest here
+    void filterOtherFlags(int commonFlags) {
+	for (const auto& t : gengTests) {
+	    if (commonFlags & t.first)
+		continue;
+	    tests.push_back(t.second.test);
+	    if (t.second.hereditary) {
+		pruneTests.push_back(t.second.test);
+		pruneVertexTests.push_back(nullptr);
+	    }
+	}
+    }
+    bool test(const Graph& g) const {
+	for (const auto& t : tests)
+	    if (!t(g))
+		return false;
+	return true;
+    }
 };
 
 template<typename T>
@@ -136,140 +213,458 @@ bool endsWith(const std::string& s, const std::string& e) {
     return s.compare(s.length() - e.length(), e.length(), e) == 0;
 }
 
-int main(int argc, char* argv[]) {
-    bool hereditary = true;
-    bool connectedOnly = false;
-    PropertyTest propertyTest = 0;
-    std::string propertyName = "";
-    int gengFlags = 0;
-    int i = 1;
-    bool countLabeled = false;
-    if (i < argc && std::string(argv[i]) == "-l") {
-	countLabeled = true;
-	++i;
-    }
-    bool determinedByConnectedComponents = !countLabeled;
-    for (; i < argc; ++i) {
-	std::string type = argv[i];
+// K2 is a block, but not biconnected
+bool isBlock(const Graph& g) {
+    return g.n() == 2 ? g.m() == 1 : Classes::isTwoVertexConnected(g);
+}
+
+Query parseQuery(const std::vector<std::string>& types, std::string name,
+		 bool componentsPossible, bool blocksPossible) {
+    Query q;
+    q.name = name;
+    q.determinedByConnectedComponents = componentsPossible;
+    q.determinedByBlocks = blocksPossible;
+    for (std::string type : types) {
 	PropertyTest test = 0;
-	if (type == "connected") {
-	    connectedOnly = true;
-	    gengFlags |= Graph::CONNECTED;
-	    continue;
-	} else if (type == "tree") {
-	    connectedOnly = true;
-	    gengFlags |= Graph::TREE;
+	PropertyVertexTest vertexTest = 0;
+	bool hereditary = false;
+	if (type == "connected" || type == "tree") {
+	    auto p = gengProperties.find(type)->second;
+	    q.connectedOnly = true;
+	    q.determinedByBlocks = false;
+	    q.closedUnderComplement = false;
+	    q.gengFlags |= p.flag;
+	    q.gengTests.push_back({p.flag, p});
 	    continue;
 	} else if (gengProperties.find(type) != gengProperties.end()) {
 	    auto p = gengProperties.find(type)->second;
-	    gengFlags |= p.flag;
-	    hereditary &= p.hereditary;
-	    determinedByConnectedComponents &= p.determinedByConnectedComponents;
-	    if (propertyName != "")
-		propertyName += ' ';
-	    propertyName += type;
+	    q.gengFlags |= p.flag;
+	    q.gengTests.push_back({p.flag, p});
+	    q.determinedByConnectedComponents &= p.determinedByConnectedComponents;
+	    q.determinedByBlocks &= p.determinedByBlocks;
+	    q.closedUnderComplement &= closedUnderComplement.count(type) > 0;
+	    if (q.name != "")
+		q.name += ' ';
+	    q.name += type;
 	    continue;
 	} else if (properties.find(type) != properties.end()) {
 	    auto p = properties.find(type)->second;
 	    test = p.test;
-	    hereditary &= p.hereditary;
-	    determinedByConnectedComponents &= p.determinedByConnectedComponents;
-	    if (propertyName != "")
-		propertyName += ' ';
-	    propertyName += type;
+	    vertexTest = p.vertexTest;
+	    hereditary = p.hereditary;
+	    q.determinedByConnectedComponents &= p.determinedByConnectedComponents;
+	    q.determinedByBlocks &= p.determinedByBlocks;
+	    q.closedUnderComplement &= closedUnderComplement.count(type) > 0;
+	    if (q.name != "")
+		q.name += ' ';
+	    q.name += type;
 	} else if (endsWith(type, "-free")) {
-	    if (propertyName != "")
-		propertyName += ' ';
+	    if (q.name != "")
+		q.name += ' ';
 	    type = type.substr(0, type.length() - std::string("-free").length());
 	    bool induced = false;
 	    if (startsWith(type, "induced-")) {
 		type = type.substr(std::string("induced-").length());
 		induced = true;
-		propertyName += "(induced) ";
+		q.name += "(induced) ";
 	    } else {
-		propertyName += "(not necessarily induced) ";
+		q.name += "(not necessarily induced) ";
 	    }
 	    Graph f = Graph::byName(type);
-	    propertyName += f.name() + "-free";
-	    test = std::not1(induced ? Subgraph::hasInducedTest(f) : Subgraph::hasTest(f));
-	    determinedByConnectedComponents &= f.isConnected();
+	    q.name += f.name() + "-free";
+	    PropertyTest has = induced ? Subgraph::hasInducedTest(f) : Subgraph::hasTest(f);
+	    test = [has](const Graph& g) { return !has(g); };
+	    auto hasWithVertex = induced ? Subgraph::hasInducedWithVertexTest(f) : Subgraph::hasWithVertexTest(f);
+	    vertexTest = [hasWithVertex](const Graph& g, int u) { return !hasWithVertex(g, u); };
+	    hereditary = true;
+	    q.determinedByConnectedComponents &= f.isConnected();
+	    q.determinedByBlocks &= Classes::isTwoVertexConnected(f);
+	    q.closedUnderComplement &= induced && f.complement().canonical() == f.canonical();
 	} else {
 	    std::cerr << "unknown graph class\n";
 	    exit(1);
 	}
-	if (!propertyTest)
-	    propertyTest = test;
-	else
-	    propertyTest = [propertyTest, test](const Graph& g) { return propertyTest(g) && test(g); };
+	q.tests.push_back(test);
+	if (hereditary) {
+	    q.pruneTests.push_back(test);
+	    q.pruneVertexTests.push_back(vertexTest);
+	}
     }
-    if (determinedByConnectedComponents)
-	gengFlags |= Graph::CONNECTED;
-    bool doPrune = hereditary && propertyTest;
-    if (!propertyTest)
-	propertyTest = [](const Graph&) { return true; };
-    std::vector<bignum> counts;
-    std::vector<double> times;
-    for (int n = 0; n <= MAXN; ++n) {
-	auto tStart = double(std::clock()) / CLOCKS_PER_SEC;
-	std::cerr << "--- n = " << n;
-	if (times.size() >= 2) {
-	    auto tn = times.back();
-	    auto tn1 = times[times.size() - 2];
-	    auto est = tn * (tn / tn1);
-	    std::cerr << " estimated time: " << est << 's' << std::endl;
-	    if (est > maxCpuTime)
-		return 0;
+    if (q.determinedByConnectedComponents) {
+	q.gengFlags |= Graph::CONNECTED;
+	q.gengTests.push_back({Graph::CONNECTED, gengProperties.find("connected")->second});
+    }
+    q.determinedByBlocks &= q.determinedByConnectedComponents;
+    if (q.determinedByBlocks) {
+	q.gengFlags |= Graph::BICONNECTED;
+	q.tests.push_back(isBlock);
+    }
+    return q;
+}
+
+void printCounts(const Query& q, bool countLabeled) {
+    const std::string& propertyName = q.name;
+    const std::vector<bignum>& counts = q.counts;
+    std::string un = countLabeled ? "" : "un";
+    if (q.connectedOnly && !q.determinedByConnectedComponents) {
+	std::cout << "number of connected " << propertyName
+		  << " undirected " << un << "labeled graph on n vertices:\n"
+		  << counts << std::endl;
+	if (!countLabeled)
+	    std::cout << "number of connected non-" << propertyName
+		      << " undirected " << un << "labeled graph on n vertices:\n"
+		      << EulerTransform::connectedNonGraphs(counts) << std::endl;
+    } else if (!q.determinedByConnectedComponents) {
+	std::cout << "number of " << propertyName
+		  << " undirected " << un << "labeled graph on n vertices:\n"
+		  << counts << std::endl;
+	if (!countLabeled)
+	    std::cout << "number of non-" << propertyName
+		      << " undirected " << un << "labeled graph on n vertices:\n"
+		      << EulerTransform::nonGraphs(counts) << std::endl;
+    } else {
+	if (q.determinedByBlocks)
+	    std::cout << "number of " << propertyName
+		      << " blocks (K2 or biconnected) on n labeled vertices:\n"
+		      << q.blockCounts << std::endl;
+	const auto& countsGeneral = countLabeled ? q.countsGeneralLabeled.result() : q.countsGeneral.result();
+	std::cout << "number of " << propertyName
+		  << " undirected " << un << "labeled graph on n vertices:\n"
+		  << countsGeneral << std::endl;
+	if (!countLabeled)
+	    std::cout << "number of non-" << propertyName
+		      << " undirected " << un << "labeled graph on n vertices:\n"
+		      << EulerTransform::nonGraphs(countsGeneral) << std::endl;
+	std::cout << "number of " << propertyName
+		  << " connected undirected " << un << "labeled graph on n vertices:\n"
+		  << counts << std::endl;
+	if (!countLabeled)
+	    std::cout << "number of non-" << propertyName
+		      << " connected undirected " << un << "labeled graph on n vertices:\n"
+		      << EulerTransform::connectedNonGraphs(counts) << std::endl;
+    }
+}
+
+// the file of this program, so that the narrower builds are found next
+// to it also when it was started through PATH; empty if unknown
+std::string executablePath(const std::string& argv0) {
+    char buf[4096];
+    ssize_t len = readlink("/proc/self/exe", buf, sizeof buf);
+    if (len > 0 && size_t(len) < sizeof buf)
+	return std::string(buf, len);
+    if (argv0.find('/') != std::string::npos)
+	return argv0;
+    const char* path = std::getenv("PATH");
+    std::istringstream dirs(path ? path : "");
+    std::string dir;
+    while (std::getline(dirs, dir, ':')) {
+	std::string file = (dir.empty() ? "." : dir) + '/' + argv0;
+	if (access(file.c_str(), X_OK) == 0)
+	    return file;
+    }
+    return "";
+}
+
+int main(int argc, char* argv[]) {
+    std::string propertyName = "";
+    Graph::Bounds bounds;
+    int i = 1;
+    bool countLabeled = false;
+    int jobs = 1;
+    std::string checkpointDir;
+    int shards = 0;
+    int worker = 0, workers = 1;
+    bool mergeOnly = false;
+    bool complementPairs = false;
+    // with -P, only print the result of part res of mod for n = partN
+    int partN = -1, partRes = 0, partMod = 1;
+    // what is computed, to tell checkpoints of different runs apart
+    std::string run = "count";
+    // the options that select what is computed, for running parts
+    // with a build for a narrower WORDSIZE
+    std::vector<std::string> partArgs;
+    for (; i < argc && argv[i][0] == '-'; ++i) {
+	std::string option = argv[i];
+	if (option == "-l") {
+	    countLabeled = true;
+	    run += " -l";
+	    partArgs.push_back(option);
+	} else if (option == "-j" && i + 1 < argc) {
+	    jobs = std::stoi(argv[++i]);
+	} else if (option == "-d" && i + 1 < argc) {
+	    bounds.minDeg = std::stoi(argv[++i]);
+	    run += " -d " + std::to_string(bounds.minDeg);
+	    partArgs.insert(partArgs.end(), {option, argv[i]});
+	    if (propertyName != "")
+		propertyName += ' ';
+	    propertyName += "min-degree-" + std::to_string(bounds.minDeg);
+	} else if (option == "-D" && i + 1 < argc) {
+	    bounds.maxDeg = std::stoi(argv[++i]);
+	    run += " -D " + std::to_string(bounds.maxDeg);
+	    partArgs.insert(partArgs.end(), {option, argv[i]});
+	    if (propertyName != "")
+		propertyName += ' ';
+	    propertyName += "max-degree-" + std::to_string(bounds.maxDeg);
+	} else if (option == "-C" && i + 1 < argc) {
+	    checkpointDir = argv[++i];
+	} else if (option == "-s" && i + 1 < argc) {
+	    shards = std::stoi(argv[++i]);
+	} else if (option == "-w" && i + 1 < argc
+		   && sscanf(argv[i + 1], "%d/%d", &worker, &workers) == 2
+		   && workers >= 1 && worker >= 0 && worker < workers) {
+	    ++i;
+	} else if (option == "-m") {
+	    mergeOnly = true;
+	} else if (option == "-c") {
+	    complementPairs = true;
+	    run += " -c";
+	    partArgs.push_back(option);
+	} else if (option == "-P" && i + 2 < argc
+		   && sscanf(argv[i + 2], "%d/%d", &partRes, &partMod) == 2
+		   && partMod >= 1 && partRes >= 0 && partRes < partMod) {
+	    partN = std::stoi(argv[++i]);
+	    ++i;
 	} else {
-	    std::cerr << std::endl;
+	    std::cerr << "usage: count [-l] [-c] [-j jobs] [-d mindeg] [-D maxdeg]"
+		      << " [-C checkpoint-dir [-s shards] [-w worker/workers] [-m]]"
+		      << " property... [, property...]...\n";
+	    exit(1);
 	}
-	bignum count = 0;
-	auto counter = [&count,&propertyTest,&countLabeled](const Graph& g) {
-			   if (propertyTest(g))
-			       count += countLabeled ? g.numLabeledGraphs() : 1;
-		       };
-	if (doPrune) {
-	    Graph::enumerate(n, counter, std::not1(propertyTest), gengFlags);
-	} else {
-	    Graph::enumerate(n, counter, gengFlags);
+    }
+    if (checkpointDir == "" && (workers > 1 || mergeOnly)) {
+	std::cerr << "count: -w and -m need a checkpoint directory (-C)\n";
+	exit(1);
+    }
+    if (shards <= 0)
+	shards = checkpointDir != "" ? 256 : 16 * jobs;
+    if (complementPairs && (bounds.minDeg >= 0 || bounds.maxDeg >= 0)) {
+	std::cerr << "count: -c cannot be combined with degree bounds\n";
+	exit(1);
+    }
+    // the complement of a connected graph need not be connected; degrees
+    // are not determined by the blocks, and unlabeled counting from
+    // blocks would need their automorphisms
+    bool componentsPossible = !complementPairs;
+    bool blocksPossible = componentsPossible && countLabeled && bounds.minDeg < 0 && bounds.maxDeg < 0;
+    int firstType = i;
+    // queries are separated by ","
+    std::vector<Query> queries;
+    std::vector<std::string> types;
+    for (; i <= argc; ++i) {
+	if (i < argc && std::string(argv[i]) != ",") {
+	    types.push_back(argv[i]);
+	    continue;
+	}
+	queries.push_back(parseQuery(types, propertyName, componentsPossible, blocksPossible));
+	types.clear();
+    }
+    for (const auto& q : queries) {
+	if (complementPairs && !q.closedUnderComplement) {
+	    std::cerr << "count: -c needs properties closed under complementation, unlike '"
+		      << q.name << "'\n";
+	    exit(1);
 	}
-	counts.push_back(count);
-	auto tEnd = double(std::clock()) / CLOCKS_PER_SEC;
+    }
+    for (int j = firstType; j < argc; ++j) {
+	run += std::string(" ") + argv[j];
+	partArgs.push_back(argv[j]);
+    }
+    // parts then hold block counts
+    if (std::any_of(queries.begin(), queries.end(), [](const Query& q) { return q.determinedByBlocks; }))
+	run += " blocks";
+    run += " shards=" + std::to_string(shards);
+    std::unique_ptr<Checkpoint> checkpoint;
+    if (checkpointDir != "") {
+	try {
+	    checkpoint.reset(new Checkpoint(checkpointDir, run));
+	} catch (const std::runtime_error& e) {
+	    std::cerr << "count: " << e.what() << '\n';
+	    exit(1);
+	}
+    }
+    int gengFlags = ~0;
+    for (const auto& q : queries)
+	gengFlags &= q.gengFlags;
+    // geng's -C drops K2, which is a block, so for n <= 2 the queries
+    // check biconnectivity themselves
+    bool blocks = std::any_of(queries.begin(), queries.end(),
+			      [](const Query& q) { return q.determinedByBlocks; });
+    for (auto& q : queries)
+	q.filterOtherFlags(blocks ? gengFlags & ~Graph::BICONNECTED : gengFlags);
+    // prune only what no query can accept any more
+    bool doPrune = std::all_of(queries.begin(), queries.end(),
+			       [](const Query& q) { return !q.pruneTests.empty(); });
+    // geng only extends graphs that were not pruned, so for hereditary
+    // properties it suffices to look at the vertex added last; with
+    // several queries, the parent may have been rejected by some
+    bool incrementalPrune = queries.size() == 1
+	&& std::all_of(queries[0].pruneVertexTests.begin(), queries[0].pruneVertexTests.end(),
+		       [](const PropertyVertexTest& t) { return bool(t); });
+    auto prune = [&](const Graph& g) {
+	for (const auto& q : queries) {
+	    bool rejected = false;
+	    for (size_t k = 0; k < q.pruneTests.size() && !rejected; ++k)
+		rejected = incrementalPrune ? !q.pruneVertexTests[k](g, g.n() - 1) : !q.pruneTests[k](g);
+	    if (!rejected)
+		return false;
+	}
+	return true;
+    };
+    // builds of this program for a narrower WORDSIZE, such as
+    // count-w16 next to count, which handle small n faster
+    std::vector<std::pair<int, std::string>> narrowerBuilds;
+    if (partN < 0) {
+	std::string self = executablePath(argv[0]);
+	for (int w : {16, 32}) {
+	    if (w >= WORDSIZE)
+		continue;
+	    std::string path = (self.empty() ? std::string("count") : self) + "-w" + std::to_string(w);
+	    if (!self.empty() && access(path.c_str(), X_OK) == 0)
+		narrowerBuilds.push_back({w, path});
+	    else
+		std::cerr << "note: " << path << " not found, counting n <= " << w
+			  << " with this build" << std::endl;
+	}
+    }
+    std::vector<double> times;
+    // whether all parts of all n so far are done, by us or other workers
+    bool complete = true;
+    for (int n = partN >= 0 ? partN : 0; n <= MAXN; ++n) {
+	auto tStart = Parallel::cpuTime();
+	if (partN < 0) {
+	    std::cerr << "--- n = " << n;
+	    if (times.size() >= 2) {
+		auto tn = times.back();
+		auto tn1 = times[times.size() - 2];
+		auto est = tn * (tn / tn1);
+		std::cerr << " estimated time: " << est << 's' << std::endl;
+		if (est > maxCpuTime)
+		    return 0;
+	    } else {
+		std::cerr << std::endl;
+	    }
+	}
+	std::vector<Counter> count(queries.size());
+	// with -c, only graphs with at most half of the edges are
+	// generated, and the others are counted as their complements
+	int halfEdges = n * (n - 1) / 4;
+	Graph::Bounds nBounds = bounds;
+	if (complementPairs)
+	    nBounds.maxEdges = halfEdges;
+	auto counter = [&](const Graph& g) {
+	    // the graph stands for itself and its complement, unless they
+	    // have the same number of edges, and so both are generated
+	    int copies = complementPairs && 2 * g.m() != n * (n - 1) / 2 ? 2 : 1;
+	    // the number of labelings is only computed once per graph
+	    uint128 weight = 0;
+	    bool weightIsBig = false;
+	    bignum bigWeight;
+	    for (size_t k = 0; k < queries.size(); ++k) {
+		if (!queries[k].test(g))
+		    continue;
+		if (!countLabeled) {
+		    count[k] += copies;
+		    continue;
+		}
+		if (weight == 0 && !weightIsBig) {
+		    if (g.n() <= Graph::MAX_N_LABELED_128) {
+			weight = g.numLabeledGraphs128();
+		    } else {
+			bigWeight = g.numLabeledGraphs();
+			weightIsBig = true;
+		    }
+		}
+		for (int c = 0; c < copies; ++c) {
+		    if (weightIsBig)
+			count[k] += bigWeight;
+		    else
+			count[k] += weight;
+		}
+	    }
+	};
+	int flags = blocks && n <= 2 ? gengFlags & ~Graph::BICONNECTED : gengFlags;
+	auto countPart = [&](int res, int mod) {
+	    // small n are not worth starting another program
+	    for (const auto& b : narrowerBuilds) {
+		if (n >= 8 && n <= b.first) {
+		    std::vector<std::string> args = {b.second, "-P", std::to_string(n),
+						     std::to_string(res) + '/' + std::to_string(mod)};
+		    args.insert(args.end(), partArgs.begin(), partArgs.end());
+		    return Parallel::runProgram(args);
+		}
+	    }
+	    for (auto& c : count)
+		c.clear();
+	    if (doPrune)
+		Graph::enumeratePart(n, res, mod, counter, prune, flags, nBounds);
+	    else
+		Graph::enumeratePart(n, res, mod, counter, nullptr, flags, nBounds);
+	    std::string result;
+	    for (const auto& c : count)
+		result += c.get().get_str() + ' ';
+	    return result;
+	};
+	if (partN >= 0) {
+	    std::cout << countPart(partRes, partMod);
+	    return 0;
+	}
+	std::vector<bignum> total(queries.size());
+	auto addPart = [&total](const std::string& c) {
+	    std::istringstream in(c);
+	    for (auto& t : total) {
+		bignum x;
+		if (!(in >> x))
+		    throw std::runtime_error("count: malformed part result '" + c + "'");
+		t += x;
+	    }
+	};
+	// small n are not worth the forking or checkpointing
+	bool sharded = n >= 8 && (jobs > 1 || checkpoint);
+	int parts = sharded ? shards : 1;
+	std::vector<int> todo;
+	int missing = 0;
+	for (int res = 0; res < parts; ++res) {
+	    std::string c;
+	    if (sharded && checkpoint && checkpoint->load(n, res, parts, c))
+		addPart(c);
+	    else if (!sharded || (!mergeOnly && res % workers == worker))
+		todo.push_back(res);
+	    else
+		++missing;
+	}
+	Parallel::forEachPart(todo.size(), jobs,
+			      [&](int k, int) { return countPart(todo[k], parts); },
+			      [&](int k, const std::string& c) {
+				  addPart(c);
+				  if (sharded && checkpoint)
+				      checkpoint->store(n, todo[k], parts, c);
+			      });
+	auto tEnd = Parallel::cpuTime();
 	double t = tEnd - tStart;
 	times.push_back(t);
 	std::cerr << "time: " << t << 's' << std::endl;
-	std::string un = countLabeled ? "" : "un";
-	if (connectedOnly && !determinedByConnectedComponents) {
-	    std::cout << "number of connected " << propertyName
-		      << " undirected " << un << "labeled graph on n vertices:\n"
-		      << counts << std::endl;
-	    if (!countLabeled)
-		std::cout << "number of connected non-" << propertyName
-			  << " undirected " << un << "labeled graph on n vertices:\n"
-			  << EulerTransform::connectedNonGraphs(counts) << std::endl;
-	} else if (!determinedByConnectedComponents) {
-	    std::cout << "number of " << propertyName
-		      << " undirected " << un << "labeled graph on n vertices:\n"
-		      << counts << std::endl;
-	    if (!countLabeled)
-		std::cout << "number of non-" << propertyName
-			  << " undirected " << un << "labeled graph on n vertices:\n"
-			  << EulerTransform::nonGraphs(counts) << std::endl;
-	} else {
-	    auto countsGeneral = EulerTransform::transform(counts);
-	    std::cout << "number of " << propertyName
-		      << " undirected " << un << "labeled graph on n vertices:\n"
-		      << countsGeneral << std::endl;
-	    if (!countLabeled) {
-		std::cout << "number of non-" << propertyName
-			  << " undirected " << un << "labeled graph on n vertices:\n"
-			  << EulerTransform::nonGraphs(countsGeneral) << std::endl;
-		std::cout << "number of " << propertyName
-			  << " connected undirected " << un << "labeled graph on n vertices:\n"
-			  << counts << std::endl;
-		std::cout << "number of non-" << propertyName
-			  << " connected undirected " << un << "labeled graph on n vertices:\n"
-			  << EulerTransform::connectedNonGraphs(counts) << std::endl;
+	if (missing) {
+	    std::cerr << missing << " of " << parts << " parts for n = " << n
+		      << " are not done yet" << std::endl;
+	    if (mergeOnly)
+		return 0;
+	    complete = false;
+	}
+	if (!complete)
+	    continue;
+	for (size_t k = 0; k < queries.size(); ++k) {
+	    Query& q = queries[k];
+	    if (q.determinedByBlocks) {
+		q.blockCounts.push_back(total[k]);
+		q.counts.push_back(q.countsFromBlocks.push(total[k]));
+	    } else {
+		q.counts.push_back(total[k]);
 	    }
+	    if (countLabeled)
+		q.countsGeneralLabeled.push(q.counts.back());
+	    else
+		q.countsGeneral.push(q.counts.back());
+	    printCounts(q, countLabeled);
 	}
     }
 
@@ -16,9 +16,16 @@
    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.	*/
 
 #include "Graph.hh"
+#include "Parallel.hh"
 #include "Subgraph.hh"
 
 int main(int argc, char* argv[]) {
+    int jobs = 1;
+    if (argc == 4 && std::string(argv[1]) == "-j") {
+	jobs = std::stoi(argv[2]);
+	argv += 2;
+	argc -= 2;
+    }
     assert(argc == 2);
     std::function<uint64_t(Graph)> countSubgraphs;
     std::string name;
@@ -35,12 +42,20 @@ int main(int argc, char* argv[]) {
     for (int n = 0; ; ++n) {
 	std::cerr << "--- n = " << n << std::endl;
 	uint64_t maxCount = 0;
-	Graph::enumerate(n, [&maxCount, &countSubgraphs](const Graph& g) {
-		uint64_t count = countSubgraphs(g);
-                if (count > maxCount) {
-		    std::cerr << count << ": " << g.toString() << std::endl;
-		    maxCount = count;
-		}
+	auto maxPart = [n, &countSubgraphs](int res, int mod) {
+	    uint64_t maxCount = 0;
+	    Graph::enumeratePart(n, res, mod, [&maxCount, &countSubgraphs](const Graph& g) {
+		    uint64_t count = countSubgraphs(g);
+		    if (count > maxCount) {
+			std::cerr << count << ": " << g.toString() << std::endl;
+			maxCount = count;
+		    }
+		});
+	    return std::to_string(maxCount);
+	};
+	int parts = jobs > 1 && n >= 8 ? 16 * jobs : 1;
+	Parallel::forEachPart(parts, jobs, maxPart, [&maxCount](int, const std::string& c) {
+		maxCount = std::max(maxCount, uint64_t(std::stoull(c)));
 	    });
 	maxCounts.push_back(maxCount);
 	std::cout << "maximum number of induced " << name
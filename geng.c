@@ -17,6 +17,10 @@
 
 #include "wordsize.h"
 
+// geng works on graphs with one setword per vertex
+#undef MAXN
+#define MAXN WORDSIZE
+
 #define GENG_MAIN geng_main
 #define OUTPROC geng_outproc
 #define PRUNE geng_prune
@@ -0,0 +1,75 @@
+/* tinygraph -- exploring graph conjectures on small graphs
+   Copyright (C) 2015  Falk Hüffner
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
+
+// Generate NamedGraphs.cc: the graphs of NamedGraphs.def with their
+// canonical forms as computed by the nauty linked here.
+
+#include "Graph.hh"
+#include "NamedGraphs.hh"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// the raw tables that Graph.cc refers to; they are never searched here
+#define NAMED_GRAPH(name, graph6) {name, graph6},
+const NamedGraph namedGraphs[] = {
+#include "NamedGraphs.def"
+};
+const NamedGraph namedGraphsByGraph6[] = {
+#include "NamedGraphs.def"
+};
+#undef NAMED_GRAPH
+const int numNamedGraphs = sizeof namedGraphs / sizeof namedGraphs[0];
+
+static std::string quote(const std::string& s) {
+    std::string r = "\"";
+    for (char c : s) {
+	if (c == '\\' || c == '"')
+	    r += '\\';
+	r += c;
+    }
+    return r + '"';
+}
+
+static void printTable(const char* name, const std::vector<std::pair<std::string, std::string>>& graphs) {
+    std::cout << "\nconst NamedGraph " << name << "[] = {\n";
+    for (const auto& p : graphs)
+	std::cout << "    {" << quote(p.first) << ", " << quote(p.second) << "},\n";
+    std::cout << "};\n";
+}
+
+int main() {
+    std::vector<std::pair<std::string, std::string>> graphs;
+    for (int i = 0; i < numNamedGraphs; ++i)
+	graphs.push_back({namedGraphs[i].name,
+			  Graph::ofGraph6(namedGraphs[i].graph6).canonical().graph6()});
+
+    std::cout << "// generated by named-graphs from NamedGraphs.def; do not edit\n\n"
+	      << "#include \"NamedGraphs.hh\"\n\n"
+	      << "const int numNamedGraphs = " << graphs.size() << ";\n";
+    std::sort(graphs.begin(), graphs.end());
+    printTable("namedGraphs", graphs);
+    std::sort(graphs.begin(), graphs.end(), [](const std::pair<std::string, std::string>& a,
+					       const std::pair<std::string, std::string>& b) {
+		  return std::tie(a.second, a.first) < std::tie(b.second, b.first);
+	      });
+    printTable("namedGraphsByGraph6", graphs);
+    return 0;
+}
@@ -22,12 +22,14 @@ int choose2(int n) {
 }
 
 int sparseSplitGraphEditing(const Graph& g) {
-    Set vs = g.vertices();
     int m = g.m();
     int minEdits = m;
-    for (Set clique : vs.subsets()) {
-	int c = clique.size();
-	int m_c = g.mSubgraph(clique);
+    Graph::InducedEdges clique(g);
+    for (auto step : g.vertices().grayCodeSubsets()) {
+	if (step.changed() >= 0)
+	    clique.toggle(step.changed());
+	int c = clique.vertices().size();
+	int m_c = clique.m();
 	int edits = (choose2(c) - m_c) + (m - m_c);
 	if (edits < minEdits)
 	    minEdits = edits;
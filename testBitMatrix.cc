@@ -0,0 +1,117 @@
+/* tinygraph -- exploring graph conjectures on small graphs
+   Copyright (C) 2015  Falk Hüffner
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
+
+#include <random>
+
+#include "BitMatrix.hh"
+#include "Invariants.hh"
+
+#include "catch.hh"
+
+static BitMatrix randomMatrix(int n, double p, std::mt19937& rng) {
+    std::bernoulli_distribution bit(p);
+    BitMatrix a(n);
+    for (int i = 0; i < n; ++i)
+	for (int j = 0; j < n; ++j)
+	    if (bit(rng))
+		a.set(i, j);
+    return a;
+}
+
+static std::vector<int> bfs(const Graph& g, int u) {
+    std::vector<int> d(g.n(), -1);
+    d[u] = 0;
+    std::vector<int> queue = {u};
+    for (size_t i = 0; i < queue.size(); ++i) {
+	int v = queue[i];
+	for (int w : g.neighbors(v)) {
+	    if (d[w] == -1) {
+		d[w] = d[v] + 1;
+		queue.push_back(w);
+	    }
+	}
+    }
+    return d;
+}
+
+TEST_CASE("BitMatrix", "[BitMatrix]" ) {
+    std::mt19937 rng;
+    for (int n = 0; n <= Graph::maxn(); n += n < 12 ? 1 : 13) {
+	for (double p : {0.5, 0.2, 0.08}) {
+	    BitMatrix a = randomMatrix(n, p, rng), b = randomMatrix(n, p, rng);
+
+	    BitMatrix t = a.transpose();
+	    for (int i = 0; i < n; ++i)
+		for (int j = 0; j < n; ++j)
+		    REQUIRE(t.get(i, j) == a.get(j, i));
+	    REQUIRE(t.transpose() == a);
+
+	    BitMatrix c = a * b;
+	    std::vector<int> counts = a.andCounts(b.transpose());
+	    for (int i = 0; i < n; ++i) {
+		for (int j = 0; j < n; ++j) {
+		    int k = 0;
+		    for (int l = 0; l < n; ++l)
+			k += a.get(i, l) && b.get(l, j);
+		    REQUIRE(c.get(i, j) == (k > 0));
+		    REQUIRE(counts[i * n + j] == k);
+		}
+	    }
+	    REQUIRE(BitMatrix::identity(n) * a == a);
+	    REQUIRE(a * BitMatrix::identity(n) == a);
+
+	    BitMatrix closure = a.transitiveClosure();
+	    BitMatrix paths = a;
+	    for (int i = 1; i < n; ++i)
+		paths |= paths * a;
+	    REQUIRE(closure == paths);
+	}
+    }
+}
+
+TEST_CASE("distanceLayers", "[BitMatrix]" ) {
+    std::mt19937 rng;
+    for (int n = 1; n <= Graph::maxn(); n += n < 12 ? 1 : 13) {
+	for (int degree : {1, 2, 4}) {
+	    std::bernoulli_distribution edge(double(degree) / n);
+	    Graph g(n);
+	    for (int u = 0; u < n; ++u)
+		for (int v = u + 1; v < n; ++v)
+		    if (edge(rng))
+			g.addEdge(u, v);
+	    std::vector<BitMatrix> layers = BitMatrix::ofGraph(g).distanceLayers();
+	    int diameter = 0, radius = Graph::maxn();
+	    bool connected = true;
+	    for (int u = 0; u < n; ++u) {
+		std::vector<int> d = bfs(g, u);
+		int eccentricity = 0;
+		for (int v = 0; v < n; ++v) {
+		    for (size_t k = 0; k < layers.size(); ++k)
+			REQUIRE(layers[k].get(u, v) == (d[v] == int(k)));
+		    if (d[v] == -1)
+			connected = false;
+		    eccentricity = std::max(eccentricity, d[v]);
+		}
+		diameter = std::max(diameter, eccentricity);
+		radius = std::min(radius, eccentricity);
+	    }
+	    REQUIRE(connected == g.isConnected());
+	    REQUIRE(Invariants::diameter(g) == (connected ? diameter : Graph::maxn()));
+	    REQUIRE(Invariants::radius(g) == (connected ? radius : 0));
+	}
+    }
+}
@@ -15,13 +15,31 @@
    with this program; if not, write to the Free Software Foundation, Inc.,
    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
 
+#include <random>
+
 #include "bits.hh"
 
 #include "catch.hh"
 
 TEST_CASE("popcount", "[bits]" ) {
     REQUIRE(popcount(0) == 0);
-    REQUIRE(popcount(-1) == MAXN);
-    REQUIRE(popcount(word(-1) >> 5) == MAXN - 5);
+    REQUIRE(popcount(-1) == WORDSIZE);
+    REQUIRE(popcount(word(-1) >> 5) == WORDSIZE - 5);
     REQUIRE(popcount(0xaa) == 4);
 }
+
+TEST_CASE("extractBits", "[bits]" ) {
+    REQUIRE(extractBits(0xb6, 0xf0) == 0xb);
+    REQUIRE(extractBits(0xb6, 0x5a) == 0x5);
+    REQUIRE(depositBits(0xb, 0xf0) == 0xb0);
+    REQUIRE(depositBits(0x5, 0x5a) == 0x12);
+    std::mt19937 rng;
+    std::uniform_int_distribution<word> bits;
+    for (int i = 0; i < 1000; ++i) {
+	word x = bits(rng), mask = bits(rng);
+	REQUIRE(extractBits(x, mask) == extractBitsPortable(x, mask));
+	REQUIRE(depositBits(x, mask) == depositBitsPortable(x, mask));
+	REQUIRE(depositBits(extractBits(x, mask), mask) == (x & mask));
+	REQUIRE(popcount(extractBits(x, mask)) == popcount(x & mask));
+    }
+}
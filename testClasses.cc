@@ -16,6 +16,7 @@
    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
 
 #include "Classes.hh"
+#include "Subgraph.hh"
 
 #include "catch.hh"
 
@@ -24,3 +25,39 @@ TEST_CASE("chordal", "[Classes]" ) {
     g.addEdge(0, 1);
     REQUIRE(Classes::isChordal(g));
 }
+
+TEST_CASE("geng filters", "[Classes]" ) {
+    std::vector<std::pair<int, std::function<bool(const Graph&)>>> filters = {
+	{Graph::CHORDAL,   Classes::isChordal},
+	{Graph::SPLIT,     Classes::isSplit},
+	{Graph::PERFECT,   Classes::isPerfect},
+	{Graph::CLAW_FREE, [](const Graph& g) { return !Subgraph::hasInducedClaw(g); }},
+	{Graph::K4_FREE,   [](const Graph& g) { return !Subgraph::hasK4(g); }},
+    };
+    for (int n = 0; n <= 7; ++n) {
+	for (const auto& filter : filters) {
+	    int expected = 0, actual = 0;
+	    Graph::enumerate(n, [&](const Graph& g) { expected += filter.second(g); });
+	    Graph::enumerate(n, [&](const Graph& g) {
+		    REQUIRE(filter.second(g));
+		    ++actual;
+		}, filter.first);
+	    REQUIRE(actual == expected);
+	}
+	Graph::Bounds bounds;
+	bounds.minDeg = 1;
+	bounds.maxDeg = 3;
+	bounds.maxEdges = n;
+	int expected = 0, actual = 0;
+	Graph::enumerate(n, [&](const Graph& g) {
+		int minDeg = Graph::maxn(), maxDeg = 0;
+		for (int u = 0; u < n; ++u) {
+		    minDeg = std::min(minDeg, g.deg(u));
+		    maxDeg = std::max(maxDeg, g.deg(u));
+		}
+		expected += minDeg >= 1 && maxDeg <= 3 && g.m() <= n;
+	    });
+	Graph::enumerate(n, [&](const Graph&) { ++actual; }, 0, bounds);
+	REQUIRE(actual == expected);
+    }
+}
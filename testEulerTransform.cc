@@ -39,3 +39,57 @@ TEST_CASE("transform", "[EulerTransform]" ) {
     REQUIRE(EulerTransform::transform(numConnectedGraphs) == numGraphs);
     REQUIRE(EulerTransform::transform(numConnectedTriangleFreeGraphs) == numTriangleFreeGraphs);
 }
+
+TEST_CASE("inverseTransform", "[EulerTransform]" ) {
+    REQUIRE(EulerTransform::inverseTransform(numGraphs) == numConnectedGraphs);
+    std::vector<EulerTransform::bignum> triangleFree(numConnectedTriangleFreeGraphs.begin(),
+						     numConnectedTriangleFreeGraphs.end());
+    REQUIRE(EulerTransform::inverseTransform(numTriangleFreeGraphs) == triangleFree);
+}
+
+TEST_CASE("incremental transform", "[EulerTransform]" ) {
+    EulerTransform::Transform t;
+    EulerTransform::InverseTransform inverse;
+    for (size_t n = 0; n < numConnectedGraphs.size(); ++n) {
+	REQUIRE(t.push(numConnectedGraphs[n]) == numGraphs[n]);
+	REQUIRE(inverse.push(numGraphs[n]) == numConnectedGraphs[n]);
+	REQUIRE(t.result().size() == n + 1);
+    }
+}
+
+TEST_CASE("graph counts", "[EulerTransform]" ) {
+    for (size_t n = 0; n < numGraphs.size(); ++n) {
+	REQUIRE(EulerTransform::numGraphs(n) == numGraphs[n]);
+	REQUIRE(EulerTransform::numConnectedGraphs(n) == numConnectedGraphs[n]);
+    }
+    REQUIRE(EulerTransform::numConnectedGraphs(30)
+	    == 334494297617902927474062588988771420592400340448497175735486787573919763092664433461017585013705594_mpz);
+    std::vector<uint64_t> none(40, 0);
+    REQUIRE(EulerTransform::nonGraphs(none).back() == EulerTransform::numGraphs(39));
+}
+
+TEST_CASE("exponentialTransform", "[EulerTransform]" ) {
+    // https://oeis.org/A001187 and https://oeis.org/A006125
+    std::vector<EulerTransform::bignum> numLabeledConnectedGraphs = {
+	1_mpz, 1_mpz, 1_mpz, 4_mpz, 38_mpz, 728_mpz, 26704_mpz, 1866256_mpz, 251548592_mpz, 66296291072_mpz,
+    };
+    std::vector<EulerTransform::bignum> numLabeledGraphs;
+    for (size_t n = 0; n < numLabeledConnectedGraphs.size(); ++n)
+	numLabeledGraphs.push_back(EulerTransform::bignum(1) << (n * (n - 1) / 2));
+    REQUIRE(EulerTransform::exponentialTransform(numLabeledConnectedGraphs) == numLabeledGraphs);
+}
+
+TEST_CASE("blockTransform", "[EulerTransform]" ) {
+    // https://oeis.org/A013922, with K2 as a block
+    std::vector<EulerTransform::bignum> numLabeledBlocks = {
+	0_mpz, 0_mpz, 1_mpz, 1_mpz, 10_mpz, 238_mpz, 11368_mpz, 1014888_mpz, 166537616_mpz, 50680432112_mpz,
+    };
+    std::vector<EulerTransform::bignum> numLabeledConnectedGraphs = {
+	1_mpz, 1_mpz, 1_mpz, 4_mpz, 38_mpz, 728_mpz, 26704_mpz, 1866256_mpz, 251548592_mpz, 66296291072_mpz,
+    };
+    REQUIRE(EulerTransform::blockTransform(numLabeledBlocks) == numLabeledConnectedGraphs);
+    // labeled trees: the only block is K2
+    std::vector<EulerTransform::bignum> k2 = { 0_mpz, 0_mpz, 1_mpz, 0_mpz, 0_mpz, 0_mpz, 0_mpz };
+    std::vector<EulerTransform::bignum> numLabeledTrees = { 1_mpz, 1_mpz, 1_mpz, 3_mpz, 16_mpz, 125_mpz, 1296_mpz };
+    REQUIRE(EulerTransform::blockTransform(k2) == numLabeledTrees);
+}
@@ -0,0 +1,136 @@
+/* tinygraph -- exploring graph conjectures on small graphs
+   Copyright (C) 2015  Falk Hüffner
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
+
+#include "Counter.hh"
+#include "Graph.hh"
+
+#include "catch.hh"
+
+TEST_CASE("trees", "[Graph]") {
+    // OEIS A000055
+    std::vector<int> numTrees = {1, 1, 1, 1, 2, 3, 6, 11, 23, 47, 106, 235, 551, 1301,
+				 3159, 7741, 19320, 48629, 123867, 317955};
+    for (int n = 0; n < int(numTrees.size()) && n <= Graph::maxn(); ++n) {
+	int count = 0;
+	Graph::enumerate(n, [&](const Graph& g) {
+		REQUIRE(g.n() == n);
+		REQUIRE(g.m() == std::max(n - 1, 0));
+		REQUIRE(g.isConnected());
+		++count;
+	    }, Graph::TREE);
+	REQUIRE(count == numTrees[n]);
+    }
+    SECTION("distinct") {
+	for (int n = 0; n <= 10; ++n) {
+	    std::vector<Graph> trees;
+	    Graph::enumerate(n, [&](const Graph& g) { trees.push_back(g.canonical()); }, Graph::TREE);
+	    for (size_t i = 0; i < trees.size(); ++i)
+		for (size_t j = 0; j < i; ++j)
+		    REQUIRE(trees[i] != trees[j]);
+	}
+    }
+    SECTION("parts and bounds") {
+	for (int n = 1; n <= 12; ++n) {
+	    int count = 0, paths = 0;
+	    for (int res = 0; res < 3; ++res)
+		Graph::enumeratePart(n, res, 3, [&](const Graph&) { ++count; }, nullptr, Graph::TREE);
+	    Graph::Bounds bounds;
+	    bounds.maxDeg = 2;
+	    Graph::enumerate(n, [&](const Graph&) { ++paths; }, Graph::TREE, bounds);
+	    REQUIRE(count == numTrees[n]);
+	    REQUIRE(paths == 1);
+	}
+    }
+}
+
+TEST_CASE("numLabeledGraphs", "[Graph]") {
+    for (int n = 0; n <= 7; ++n) {
+	bignum sum = 0;
+	Graph::enumerate(n, [&](const Graph& g) {
+		REQUIRE(toBignum(g.numLabeledGraphs128()) == g.numLabeledGraphs());
+		sum += g.numLabeledGraphs();
+	    });
+	// 2^(n choose 2)
+	REQUIRE(sum == bignum(1) << (n * (n - 1) / 2));
+    }
+}
+
+TEST_CASE("maxn", "[Graph]") {
+    int n = Graph::maxn();
+    Graph g = Graph::cycle(n);
+    REQUIRE(g.m() == n);
+    REQUIRE(g.isConnected());
+    REQUIRE(Graph::ofGraph6(g.graph6()) == g);
+    Graph p = g;
+    p.deleteVertex(0);
+    REQUIRE(p.m() == n - 2);
+    REQUIRE(p.hasEdge(0, 1));
+    REQUIRE(p.hasEdge(n - 3, n - 2));
+    REQUIRE(Graph::ofGraph6(p.graph6()) == p);
+    Set even;
+    for (int u = 0; u < n; u += 2)
+	even.add(u);
+    REQUIRE(g.subgraph(even).m() == 0);
+    REQUIRE(g.subgraph(g.vertices() - 0) == p);
+}
+
+TEST_CASE("InducedEdges", "[Graph]") {
+    // two triangles joined by two edges
+    Graph g(6, {{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 4}, {4, 5}, {5, 3}, {0, 5}});
+    Graph::InducedEdges es(g, {0, 1});
+    REQUIRE(es.m() == 1);
+    es.add(2);
+    REQUIRE(es.m() == 3);
+    es.remove(0);
+    REQUIRE(es.m() == 1);
+    REQUIRE(es.vertices() == Set({1, 2}));
+    Graph::InducedEdges running(g);
+    int n = 0;
+    for (auto step : g.vertices().grayCodeSubsets()) {
+	if (step.changed() >= 0)
+	    running.toggle(step.changed());
+	REQUIRE(running.vertices() == step.subset());
+	REQUIRE(running.m() == g.mSubgraph(step.subset()));
+	++n;
+    }
+    REQUIRE(n == 64);
+}
+
+TEST_CASE("name", "[Graph]") {
+    REQUIRE(Graph::byName("claw").name() == "claw");
+    // tadpole and necktie are the same graph
+    REQUIRE(Graph::byName("tadpole").name() == "necktie");
+    // relabeled bull: triangle 2-3-4 with pendant vertices 0 and 1
+    REQUIRE(Graph(5, {{2, 3}, {3, 4}, {4, 2}, {0, 2}, {1, 3}}).name() == "bull");
+    REQUIRE(Graph::byName("C5").name() == "C5");
+    REQUIRE((Graph::byName("house").complement()).name() == "P5");
+    REQUIRE(Graph::byName("paw+claw+paw").name() == "claw+2paw");
+}
+
+TEST_CASE("Counter", "[Graph]") {
+    Counter c;
+    uint128 big = ~uint128(0) - 5;
+    c += big;
+    c += 10;
+    c += bignum(7);
+    bignum expected = toBignum(big) + 17;
+    REQUIRE(c.get() == expected);
+    c += big;
+    REQUIRE(c.get() == expected + toBignum(big));
+    c.clear();
+    REQUIRE(c.get() == 0);
+}
@@ -0,0 +1,59 @@
+/* tinygraph -- exploring graph conjectures on small graphs
+   Copyright (C) 2015  Falk Hüffner
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
+
+#include <random>
+
+#include "Graph.hh"
+#include "Rows.hh"
+
+#include "catch.hh"
+
+TEST_CASE("Rows", "[Rows]" ) {
+    std::mt19937 rng;
+    std::bernoulli_distribution edge(1.0 / 3), inMask(0.5);
+    for (int n = 0; n <= Graph::maxn(); ++n) {
+	for (int t = 0; t < 10; ++t) {
+	    Graph g(n);
+	    for (int u = 0; u < n; ++u)
+		for (int v = u + 1; v < n; ++v)
+		    if (edge(rng))
+			g.addEdge(u, v);
+	    Set mask;
+	    for (int u = 0; u < n; ++u)
+		if (inMask(rng))
+		    mask.add(u);
+
+	    int m = 0, mMasked = 0;
+	    for (int u = 0; u < n; ++u)
+		m += g.deg(u);
+	    for (int u : mask)
+		mMasked += (g.neighbors(u) & mask).size();
+	    REQUIRE(Rows::popcount(g.neighbors(), n) == m);
+	    REQUIRE(Rows::popcountMasked(g.neighbors(), n, mask) == mMasked);
+
+	    int counts[MAXN];
+	    Rows::popcounts(g.neighbors(), n, mask, counts);
+	    for (int u = 0; u < n; ++u)
+		REQUIRE(counts[u] == (g.neighbors(u) & mask).size());
+
+	    Set out[MAXN];
+	    Rows::complement(g.neighbors(), n, out);
+	    for (int u = 0; u < MAXN; ++u)
+		REQUIRE(out[u] == (u < n ? g.nonneighbors(u) : Set()));
+	}
+    }
+}
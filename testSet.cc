@@ -16,6 +16,10 @@
    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.  */
 
 #include "Set.hh"
+#include "BasicSet.hh"
+
+#include <algorithm>
+#include <vector>
 
 #include "catch.hh"
 
@@ -157,6 +161,31 @@ TEST_CASE("Set", "[Set]") {
 	}
 	REQUIRE(n == 2);
     }
+    SECTION("grayCodeSubsets") {
+	std::vector<Set> subsets;
+	Set last;
+	for (auto step : s2.grayCodeSubsets()) {
+	    Set s = step.subset();
+	    REQUIRE(s.isSubset(s2));
+	    if (subsets.empty()) {
+		REQUIRE(s.isEmpty());
+		REQUIRE(step.changed() == -1);
+	    } else {
+		REQUIRE((s ^ last) == Set({step.changed()}));
+		REQUIRE(step.added() == s.contains(step.changed()));
+	    }
+	    REQUIRE(std::find(subsets.begin(), subsets.end(), s) == subsets.end());
+	    subsets.push_back(s);
+	    last = s;
+	}
+	REQUIRE(subsets.size() == 1u << s2.size());
+	int n = 0;
+	for (auto step : empty.grayCodeSubsets()) {
+	    REQUIRE(step.subset() == empty);
+	    ++n;
+	}
+	REQUIRE(n == 1);
+    }
     SECTION("combinations") {
 	int n = 0;
 	for (Set s : empty.combinations(0)) {
@@ -203,6 +232,45 @@ TEST_CASE("Set", "[Set]") {
 	}
 	REQUIRE(n == (all.size() * (all.size() - 1)) / 2);
     }
+    SECTION("rank") {
+	Set s = {1, 3, 4, 7, 8, 9, Set::MAX_ELEMENT};
+	auto subsets = s.subsets();
+	std::vector<Set> ts;
+	for (Set t : subsets)
+	    ts.push_back(t);
+	REQUIRE(subsets.size() == ts.size());
+	std::vector<Set> chunked;
+	for (uint64_t r = 0; r < ts.size(); ++r) {
+	    REQUIRE(subsets.rank(ts[r]) == r);
+	    REQUIRE(subsets.unrank(r) == ts[r]);
+	    if (r % 10 == 0)
+		for (Set t : subsets.range(r, std::min<uint64_t>(r + 10, ts.size())))
+		    chunked.push_back(t);
+	}
+	REQUIRE(chunked == ts);
+	for (int k = 0; k <= s.size(); ++k) {
+	    auto combinations = s.combinations(k);
+	    ts.clear();
+	    for (Set t : combinations)
+		ts.push_back(t);
+	    REQUIRE(combinations.size() == ts.size());
+	    chunked.clear();
+	    for (uint64_t r = 0; r < ts.size(); ++r) {
+		REQUIRE(combinations.rank(ts[r]) == r);
+		REQUIRE(combinations.unrank(r) == ts[r]);
+		if (r % 3 == 0)
+		    for (Set t : combinations.range(r, std::min<uint64_t>(r + 3, ts.size())))
+			chunked.push_back(t);
+	    }
+	    REQUIRE(chunked == ts);
+	}
+	for (Set t : subsets.range(5, 5)) {
+	    CAPTURE(t);
+	    REQUIRE(false);
+	}
+	REQUIRE(s.combinations(s.size() + 1).size() == 0);
+	REQUIRE(Set::ofRange(16).combinations(8).size() == 12870);
+    }
     SECTION("toggle") {
 	s2.toggle(Set::MAX_ELEMENT);
 	s2.toggle(0);
@@ -226,3 +294,150 @@ TEST_CASE("Set", "[Set]") {
 	REQUIRE(all2 == all);
     }
 }
+
+TEST_CASE("BasicSet", "[Set]") {
+    typedef BasicSet<3> S;
+    const int W = WORDSIZE;
+    S empty;
+    S s = {0, W - 1, W, W + 5, 2 * W + 1, S::MAX_ELEMENT};
+    S all = S::ofRange(S::MAX_ELEMENT + 1);
+    std::vector<int> elements = {0, W - 1, W, W + 5, 2 * W + 1, S::MAX_ELEMENT};
+
+    SECTION("basics") {
+	REQUIRE(S::MAX_ELEMENT == 3 * W - 1);
+	REQUIRE(S::ofRange(W + 3).size() == W + 3);
+	REQUIRE(S::ofRange(W + 3).max() == W + 2);
+	REQUIRE(all.size() == 3 * W);
+	REQUIRE(s.size() == 6);
+	REQUIRE(s.min() == 0);
+	REQUIRE(s.max() == S::MAX_ELEMENT);
+	REQUIRE((s - 0).min() == W - 1);
+	REQUIRE((s - S::MAX_ELEMENT).max() == 2 * W + 1);
+	REQUIRE(s.contains(W));
+	REQUIRE(!s.contains(W + 1));
+	REQUIRE((s & S::ofRange(W + 1)) == S({0, W - 1, W}));
+	REQUIRE((~s).size() == 3 * W - 6);
+	std::vector<int> xs;
+	for (int x : s)
+	    xs.push_back(x);
+	REQUIRE(xs == elements);
+	for (int x : empty)
+	    REQUIRE(false);
+	S s1 = s;
+	xs.clear();
+	while (s1.nonempty())
+	    xs.push_back(s1.pop());
+	REQUIRE(xs == elements);
+    }
+    SECTION("above") {
+	REQUIRE(s.above(W - 1) == S({W, W + 5, 2 * W + 1, S::MAX_ELEMENT}));
+	REQUIRE(s.above(S::MAX_ELEMENT).isEmpty());
+	REQUIRE(s.belowEq(W) == S({0, W - 1, W}));
+	REQUIRE(s.below(W) == S({0, W - 1}));
+	REQUIRE(s.below(0).isEmpty());
+	REQUIRE(all.above(W).size() == 2 * W - 1);
+    }
+    SECTION("extract") {
+	S mask = {1, W - 1, W + 5, W + 6, 2 * W + 1, S::MAX_ELEMENT};
+	REQUIRE(s.extract(mask) == S({1, 2, 4, 5}));
+	REQUIRE(all.extract(mask) == S::ofRange(6));
+	REQUIRE(s.extract(all) == s);
+	REQUIRE(s.deleted(W - 1) == S({0, W - 1, W + 4, 2 * W, S::MAX_ELEMENT - 1}));
+	REQUIRE(s.deleted(1) == S({0, W - 2, W - 1, W + 4, 2 * W, S::MAX_ELEMENT - 1}));
+	REQUIRE(s.shifted(W + 1) == S({W + 1, 2 * W, 2 * W + 1, 2 * W + 6}));
+	REQUIRE(s.shifted(0) == s);
+	word row[3];
+	s.toNauty(row, 3);
+	REQUIRE(S::ofNauty(row, 3) == s);
+	REQUIRE(row[1] == reverseBits(word(1) | word(1) << 5));
+    }
+    SECTION("subsets") {
+	int n = 0;
+	S last;
+	for (S t : s.subsets()) {
+	    REQUIRE(t.isSubset(s));
+	    REQUIRE((n == 0 || t != last));
+	    last = t;
+	    ++n;
+	}
+	REQUIRE(n == 1 << s.size());
+	n = 0;
+	for (S t : empty.subsets()) {
+	    REQUIRE(t == empty);
+	    ++n;
+	}
+	REQUIRE(n == 1);
+    }
+    SECTION("grayCodeSubsets") {
+	std::vector<S> subsets;
+	for (auto step : s.grayCodeSubsets()) {
+	    S t = step.subset();
+	    if (!subsets.empty())
+		REQUIRE((t ^ subsets.back()) == S({step.changed()}));
+	    REQUIRE(std::find(subsets.begin(), subsets.end(), t) == subsets.end());
+	    subsets.push_back(t);
+	}
+	REQUIRE(subsets.size() == 1u << s.size());
+    }
+    SECTION("combinations") {
+	// in the same order as those of Set
+	std::vector<S> combs;
+	for (S t : s.combinations(3))
+	    combs.push_back(t);
+	std::vector<S> expected;
+	for (Set t : Set::ofRange(6).combinations(3)) {
+	    S u;
+	    for (int x : t)
+		u.add(elements[x]);
+	    expected.push_back(u);
+	}
+	REQUIRE(combs.size() == 20);
+	REQUIRE(combs == expected);
+	int n = 0;
+	for (S t : s.combinations(0)) {
+	    REQUIRE(t.isEmpty());
+	    ++n;
+	}
+	REQUIRE(n == 1);
+	for (S t : s.combinations(7)) {
+	    CAPTURE(t);
+	    REQUIRE(false);
+	}
+	n = 0;
+	for (S t : all.combinations(2)) {
+	    REQUIRE(t.size() == 2);
+	    ++n;
+	}
+	REQUIRE(n == (all.size() * (all.size() - 1)) / 2);
+    }
+    SECTION("rank") {
+	auto subsets = s.subsets();
+	std::vector<S> ts;
+	for (S t : subsets)
+	    ts.push_back(t);
+	REQUIRE(subsets.size() == ts.size());
+	std::vector<S> chunked;
+	for (uint64_t r = 0; r < ts.size(); ++r) {
+	    REQUIRE(subsets.rank(ts[r]) == r);
+	    REQUIRE(subsets.unrank(r) == ts[r]);
+	    if (r % 5 == 0)
+		for (S t : subsets.range(r, std::min<uint64_t>(r + 5, ts.size())))
+		    chunked.push_back(t);
+	}
+	REQUIRE(chunked == ts);
+	auto combinations = s.combinations(3);
+	ts.clear();
+	chunked.clear();
+	for (S t : combinations)
+	    ts.push_back(t);
+	REQUIRE(combinations.size() == 20);
+	for (uint64_t r = 0; r < ts.size(); ++r) {
+	    REQUIRE(combinations.rank(ts[r]) == r);
+	    REQUIRE(combinations.unrank(r) == ts[r]);
+	    if (r % 3 == 0)
+		for (S t : combinations.range(r, std::min<uint64_t>(r + 3, ts.size())))
+		    chunked.push_back(t);
+	}
+	REQUIRE(chunked == ts);
+    }
+}
@@ -56,3 +56,67 @@ TEST_CASE("Subgraph", "[Subgraph]") {
 	    });
     }
 }
+
+TEST_CASE("SubgraphWithVertex", "[Subgraph]") {
+    std::vector<std::string> names = {"P3", "K3", "claw", "C4", "K4", "P4", "P5", "bull"};
+    for (int n = 0; n <= 7; ++n) {
+	Graph::enumerate(n, [&](const Graph& g) {
+		for (const auto& name : names) {
+		    Graph f = Graph::byName(name);
+		    auto inducedTest = Subgraph::hasInducedWithVertexTest(f);
+		    auto test = Subgraph::hasWithVertexTest(f);
+		    bool anyInduced = false, any = false;
+		    for (int u = 0; u < g.n(); ++u) {
+			bool induced = Subgraph::hasInducedWithVertex(g, f, u);
+			REQUIRE(inducedTest(g, u) == induced);
+			anyInduced |= induced;
+			any |= test(g, u);
+		    }
+		    REQUIRE(anyInduced == Subgraph::hasInduced(g, f));
+		    REQUIRE(any == Subgraph::hasTest(f)(g));
+		}
+	    });
+    }
+}
+
+TEST_CASE("SubgraphEmptyPattern", "[Subgraph]") {
+    // every graph contains the empty graph, also as induced subgraph
+    Graph empty(0);
+    auto inducedTest = Subgraph::hasInducedWithVertexTest(empty);
+    auto test = Subgraph::hasWithVertexTest(empty);
+    for (const Graph& g : {Graph(1), Graph::byName("P4"), Graph::byName("K5")}) {
+	REQUIRE(Subgraph::hasTest(empty)(g));
+	REQUIRE(Subgraph::hasInducedTest(empty)(g));
+	for (int u = 0; u < g.n(); ++u) {
+	    REQUIRE(inducedTest(g, u));
+	    REQUIRE(test(g, u));
+	    REQUIRE(Subgraph::hasInducedWithVertex(g, empty, u));
+	}
+    }
+}
+
+TEST_CASE("SubgraphRegistry", "[Subgraph]") {
+    // the P4 0-2-1-3, registered under one labeling and looked up
+    // under another
+    Graph p4(4, {{0, 2}, {2, 1}, {1, 3}});
+    // the registry outlives this test, so no captures
+    static int calls;
+    calls = 0;
+    Subgraph::registerHasInducedTest(p4, [](const Graph& g) {
+	    ++calls;
+	    return Subgraph::hasInduced(g, Graph::byName("P4"));
+	});
+    Subgraph::registerCountInducedFunction(p4, [](const Graph& g) {
+	    ++calls;
+	    return Subgraph::countInducedP4s(g);
+	});
+    auto has = Subgraph::hasInducedTest(Graph::byName("P4"));
+    auto count = Subgraph::countInducedFunction(Graph::byName("P4"));
+    REQUIRE(has(Graph::byName("C5")));
+    REQUIRE(!has(Graph::byName("C4")));
+    REQUIRE(count(Graph::byName("C5")) == 5);
+    REQUIRE(calls == 3);
+    // patterns without a registered implementation still work
+    REQUIRE(!Subgraph::hasInducedTest(Graph::byName("banner"))(Graph::byName("C5")));
+    REQUIRE(Subgraph::hasTest(Graph::byName("P4"))(Graph::byName("C5")));
+}
@@ -18,13 +18,26 @@
 #ifndef TINYGRAPH_WORDSIZE_H_INCLUDED
 #define TINYGRAPH_WORDSIZE_H_INCLUDED
 
-// change to 64 for larger range of n, or 16 for possibly faster processing
-#define WORDSIZE 32
+// change to 32 or 16 for possibly faster processing; count already
+// runs small n with the narrower builds count-w16 and count-w32, for
+// which the Makefile overrides this
+#ifndef WORDSIZE
+#define WORDSIZE 64
+#endif
 
 #if WORDSIZE != 16 && WORDSIZE != 32 && WORDSIZE != 64
 #error WORDSIZE must be 16, 32, or 64
 #endif
 
+// maximum number of vertices; with WORDSIZE 64, 128 or 256 allow
+// larger graphs, which use several words per vertex and can be
+// examined, but not generated by geng
+#ifndef MAXN
 #define MAXN WORDSIZE
+#endif
+
+#if MAXN != WORDSIZE && !(WORDSIZE == 64 && (MAXN == 128 || MAXN == 256))
+#error MAXN must be WORDSIZE, or 128 or 256 with WORDSIZE 64
+#endif
 
 #endif // TINYGRAPH_WORDSIZE_H_INCLUDED